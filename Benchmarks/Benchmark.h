@@ -0,0 +1,215 @@
+#pragma once
+#include <JuceHeader.h>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+// ============================================================================
+// Bench — minimal benchmark harness for the DSP layer
+// Responsibility: Times a block callback and reports mean ns/sample and the
+// worst single block, the two numbers that decide audio-thread headroom.
+// Every reported timing and accuracy check is also collected so main() can
+// write the whole run as JSON for release-to-release comparison. Checks
+// given an accepted range fail the run when they fall outside it, so the
+// suites double as CTest regression tests.
+// ============================================================================
+namespace Bench {
+
+    struct Result {
+        juce::String suite;
+        juce::String name;
+        double sampleRate   = 0.0;
+        int    blockSize    = 0;
+        double nsPerSample  = 0.0;
+        double worstBlockUs = 0.0;
+        juce::NamedValueSet params;   // extra axes: mode, active voices, ...
+    };
+
+    // Values a check accepts, bounds included
+    struct Range {
+        double low  = -std::numeric_limits<double>::infinity();
+        double high =  std::numeric_limits<double>::infinity();
+
+        bool contains(double v) const noexcept { return v >= low && v <= high; }
+    };
+
+    inline Range atMost(double high) { return { -std::numeric_limits<double>::infinity(), high }; }
+    inline Range exactly(double value) { return { value, value }; }
+
+    // An accuracy figure measured against a reference implementation
+    struct Check {
+        juce::String suite;
+        juce::String name;
+        double value = 0.0;
+        juce::String unit;
+        bool limited = false;   // false: informational only
+        Range accepted;
+        bool passed = true;
+    };
+
+    struct Options {
+        double seconds = 5.0;    // audio time per timed run
+        juce::String only;       // run only suites whose name contains this
+    };
+
+    inline Options& options() {
+        static Options o;
+        return o;
+    }
+
+    inline std::vector<Result>& results() {
+        static std::vector<Result> r;
+        return r;
+    }
+
+    inline std::vector<Check>& checks() {
+        static std::vector<Check> c;
+        return c;
+    }
+
+    // Suite name used for everything reported until the next beginSuite()
+    inline juce::String& currentSuite() {
+        static juce::String s;
+        return s;
+    }
+
+    // Prints the suite header; returns false if --only filters it out
+    inline bool beginSuite(const juce::String& suite, const juce::String& description) {
+        if (options().only.isNotEmpty() && ! suite.containsIgnoreCase(options().only))
+            return false;
+        currentSuite() = suite;
+        std::printf("\n== %s: %s ==\n", suite.toRawUTF8(), description.toRawUTF8());
+        return true;
+    }
+
+    // Calls processBlock(blockSize) for options().seconds of audio after a
+    // short warm-up
+    template <typename ProcessFn>
+    Result run(const juce::String& name, double sampleRate, int blockSize, ProcessFn&& processBlock)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const int numBlocks = juce::jmax(1, static_cast<int>(sampleRate * options().seconds) / blockSize);
+        for (int i = 0; i < juce::jmin(numBlocks, 64); ++i)
+            processBlock(blockSize);
+
+        double totalNs = 0.0, worstNs = 0.0;
+        for (int i = 0; i < numBlocks; ++i) {
+            const auto start = Clock::now();
+            processBlock(blockSize);
+            const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            totalNs += ns;
+            worstNs  = juce::jmax(worstNs, ns);
+        }
+
+        Result r;
+        r.suite        = currentSuite();
+        r.name         = name;
+        r.sampleRate   = sampleRate;
+        r.blockSize    = blockSize;
+        r.nsPerSample  = totalNs / (static_cast<double>(numBlocks) * blockSize);
+        r.worstBlockUs = worstNs * 0.001;
+        return r;
+    }
+
+    inline void print(const Result& r) {
+        juce::String label = r.name;
+        for (const auto& p : r.params)
+            label << " " << p.name.toString() << "=" << p.value.toString();
+
+        std::printf("%-44s %7.0f Hz %5d  %9.3f ns/sample  %9.2f us worst block\n",
+                    label.toRawUTF8(), r.sampleRate, r.blockSize, r.nsPerSample, r.worstBlockUs);
+    }
+
+    // Prints a timing and keeps it for the JSON report
+    inline void report(Result r, const juce::NamedValueSet& params = {}) {
+        r.params = params;
+        print(r);
+        results().push_back(r);
+    }
+
+    // Prints an informational figure (a size, a time) and keeps it for the
+    // JSON report
+    inline void reportCheck(const juce::String& name, double value, const juce::String& unit) {
+        std::printf("%-60s %12.5f %s\n", name.toRawUTF8(), value, unit.toRawUTF8());
+        checks().push_back({ currentSuite(), name, value, unit });
+    }
+
+    // Prints an accuracy figure and keeps it for the JSON report; a value
+    // outside `accepted` fails the run
+    inline void reportCheck(const juce::String& name, double value, const juce::String& unit, Range accepted) {
+        const bool passed = accepted.contains(value);
+        std::printf("%-60s %12.5f %s%s\n", name.toRawUTF8(), value, unit.toRawUTF8(),
+                    passed ? "" : "   FAILED");
+        checks().push_back({ currentSuite(), name, value, unit, true, accepted, passed });
+    }
+
+    inline int failedChecks() {
+        int failed = 0;
+        for (const auto& c : checks())
+            failed += c.passed ? 0 : 1;
+        return failed;
+    }
+
+    // Deterministic "music" for components whose cost depends on the input:
+    // a bass line, a mid chord and bright noise at roughly -12 dBFS, with the
+    // balance drifting over a few seconds so Smart Auto sees profile changes.
+    inline juce::AudioBuffer<float> makeMusic(double sampleRate, double seconds, int numChannels) {
+        const int numSamples = static_cast<int>(sampleRate * seconds);
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+        const double twoPi = juce::MathConstants<double>::twoPi;
+
+        for (int i = 0; i < numSamples; ++i) {
+            const double t = i / sampleRate;
+            const auto drift = static_cast<float>(0.5 + 0.5 * std::sin(twoPi * t / 7.0));
+            const auto bass  = static_cast<float>(std::sin(twoPi * 55.0 * t));
+            const auto mid   = static_cast<float>(std::sin(twoPi * 440.0 * t) + std::sin(twoPi * 554.4 * t)) * 0.5f;
+            for (int ch = 0; ch < numChannels; ++ch)
+                buffer.setSample(ch, i, 0.25f * (drift * bass + (1.0f - drift) * mid) + 0.03f * noise(rng));
+        }
+        return buffer;
+    }
+
+    // Copies consecutive blocks of a source buffer into a work buffer,
+    // wrapping at the end, so a timed callback always sees fresh input.
+    template <typename SampleType>
+    class Feeder {
+    public:
+        Feeder(const juce::AudioBuffer<SampleType>& sourceToUse, int maxBlockSize)
+            : source(sourceToUse), work(sourceToUse.getNumChannels(), maxBlockSize) {}
+
+        juce::AudioBuffer<SampleType>& next(int numSamples) {
+            if (readPos + numSamples > source.getNumSamples())
+                readPos = 0;
+            work.setSize(source.getNumChannels(), numSamples, false, false, true);
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                work.copyFrom(ch, 0, source, ch, readPos, numSamples);
+            readPos += numSamples;
+            return work;
+        }
+
+    private:
+        const juce::AudioBuffer<SampleType>& source;
+        juce::AudioBuffer<SampleType> work;
+        int readPos = 0;
+    };
+
+    // Axes shared by every suite
+    inline constexpr double sampleRates[] = { 44100.0, 48000.0, 96000.0 };
+    inline constexpr int    blockSizes[]  = { 32, 64, 256, 1024 };
+
+    // One entry point per component suite
+    void runOscillatorBankBenchmarks();
+    void runSidechainCompressorBenchmarks();
+    void runSmartAutoEngineBenchmarks();
+    void runGoertzelBankBenchmarks();
+    void runSolfeggioEngineBenchmarks();
+    void runProcessorBenchmarks();
+    void runStateBenchmarks();
+
+} // namespace Bench
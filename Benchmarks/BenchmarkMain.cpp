@@ -0,0 +1,134 @@
+#include "Benchmark.h"
+#include "SimdLanes.h"
+
+namespace {
+
+    constexpr const char* usage =
+        "Usage: SolfeggioBenchmarks [options]\n"
+        "\n"
+        "      --json=<file>     also write all results to <file> as JSON\n"
+        "      --seconds=<s>     audio time per timed run (default 5)\n"
+        "      --only=<suite>    run only suites whose name contains <suite>\n"
+        "  -h, --help            show this text\n"
+        "\n"
+        "Exits with status 1 if any accuracy check is out of its accepted range.\n";
+
+    juce::String simdName() {
+       #if SOLFEGGIO_SIMD_AVX
+        return "avx";
+       #elif SOLFEGGIO_SIMD_SSE
+        return "sse";
+       #elif SOLFEGGIO_SIMD_NEON
+        return "neon";
+       #else
+        return "scalar";
+       #endif
+    }
+
+    // Schema: { version, timestamp, build{...}, options{...}, results[], checks[] }.
+    // Checks with an accepted range also carry low / high and passed.
+    // Results are keyed by suite + name + sampleRate + blockSize + params, so
+    // two reports can be joined on those fields to spot regressions.
+    juce::var toJson() {
+        juce::DynamicObject::Ptr build = new juce::DynamicObject();
+        build->setProperty("version", ProjectInfo::versionString);
+        build->setProperty("simd", simdName());
+        build->setProperty("os", juce::SystemStats::getOperatingSystemName());
+        build->setProperty("cpu", juce::SystemStats::getCpuModel());
+       #if JUCE_DEBUG
+        build->setProperty("config", "debug");
+       #else
+        build->setProperty("config", "release");
+       #endif
+
+        juce::DynamicObject::Ptr opts = new juce::DynamicObject();
+        opts->setProperty("seconds", Bench::options().seconds);
+
+        juce::Array<juce::var> results;
+        for (const auto& r : Bench::results()) {
+            juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+            obj->setProperty("suite", r.suite);
+            obj->setProperty("name", r.name);
+            obj->setProperty("sampleRate", r.sampleRate);
+            obj->setProperty("blockSize", r.blockSize);
+            obj->setProperty("nsPerSample", r.nsPerSample);
+            obj->setProperty("worstBlockUs", r.worstBlockUs);
+
+            juce::DynamicObject::Ptr params = new juce::DynamicObject();
+            for (const auto& p : r.params)
+                params->setProperty(p.name, p.value);
+            obj->setProperty("params", params.get());
+
+            results.add(obj.get());
+        }
+
+        juce::Array<juce::var> checks;
+        for (const auto& c : Bench::checks()) {
+            juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+            obj->setProperty("suite", c.suite);
+            obj->setProperty("name", c.name);
+            obj->setProperty("value", c.value);
+            obj->setProperty("unit", c.unit);
+            if (c.limited) {
+                if (std::isfinite(c.accepted.low))
+                    obj->setProperty("low", c.accepted.low);
+                if (std::isfinite(c.accepted.high))
+                    obj->setProperty("high", c.accepted.high);
+                obj->setProperty("passed", c.passed);
+            }
+            checks.add(obj.get());
+        }
+
+        juce::DynamicObject::Ptr root = new juce::DynamicObject();
+        root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+        root->setProperty("build", build.get());
+        root->setProperty("options", opts.get());
+        root->setProperty("results", results);
+        root->setProperty("checks", checks);
+        return root.get();
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // The processor suite builds SolfeggioProcessor instances, whose APVTS
+    // needs a message manager.
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::ArgumentList args(argc, argv);
+    if (args.containsOption("--help|-h")) {
+        std::printf("%s", usage);
+        return 0;
+    }
+
+    const auto jsonPath = args.removeValueForOption("--json");
+    if (const auto seconds = args.removeValueForOption("--seconds"); seconds.isNotEmpty())
+        Bench::options().seconds = juce::jmax(0.01, seconds.getDoubleValue());
+    Bench::options().only = args.removeValueForOption("--only");
+
+    // Components run inside processBlock with denormals flushed; time them
+    // the same way, or silent inputs measure denormal stalls instead
+    juce::ScopedNoDenormals noDenormals;
+
+    Bench::runOscillatorBankBenchmarks();
+    Bench::runSidechainCompressorBenchmarks();
+    Bench::runSmartAutoEngineBenchmarks();
+    Bench::runGoertzelBankBenchmarks();
+    Bench::runSolfeggioEngineBenchmarks();
+    Bench::runProcessorBenchmarks();
+    Bench::runStateBenchmarks();
+
+    if (jsonPath.isNotEmpty()) {
+        const auto json = juce::JSON::toString(toJson());
+        if (! juce::File::getCurrentWorkingDirectory().getChildFile(jsonPath).replaceWithText(json)) {
+            std::fprintf(stderr, "SolfeggioBenchmarks: cannot write %s\n", jsonPath.toRawUTF8());
+            return 1;
+        }
+    }
+
+    if (const int failed = Bench::failedChecks(); failed > 0) {
+        std::fprintf(stderr, "SolfeggioBenchmarks: %d check(s) FAILED\n", failed);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include "Benchmark.h"
+#include "SolfeggioProcessor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    void setParameter(SolfeggioProcessor& processor, const juce::String& id, float value) {
+        if (auto* p = processor.apvts.getParameter(id))
+            p->setValueNotifyingHost(p->convertTo0to1(value));
+    }
+
+    void setActiveVoices(SolfeggioProcessor& processor, int activeVoices) {
+        for (int v = 0; v < Solfeggio::NUM_FREQUENCIES; ++v) {
+            const float freq = Solfeggio::Frequencies[static_cast<size_t>(v)];
+            const bool on = v < activeVoices;
+            setParameter(processor, Solfeggio::Params::getOnID(freq), on ? 1.0f : 0.0f);
+            setParameter(processor, Solfeggio::Params::getGainID(freq), on ? 0.5f : 0.0f);
+        }
+    }
+
+    // 5.1 with C at 0.25, Ls at 0.5 and LFE left at its default 0, on silent
+    // input so out = solfeggio * mix * send: every channel should be its
+    // send times the front left (send 1). Returns the largest difference.
+    double channelSendError(double sampleRate) {
+        SolfeggioProcessor processor;
+        juce::AudioProcessor::BusesLayout buses;
+        buses.inputBuses.add(juce::AudioChannelSet::create5point1());
+        buses.outputBuses.add(juce::AudioChannelSet::create5point1());
+        if (! processor.setBusesLayout(buses))
+            return 1.0;
+
+        const int blockSize = 512;
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+        processor.setChannelSend(juce::AudioChannelSet::centre, 0.25f);
+        processor.setChannelSend(juce::AudioChannelSet::leftSurround, 0.5f);
+        setParameter(processor, Solfeggio::Params::autoMode.getParamID(), 0.0f);
+        setParameter(processor, Solfeggio::Params::masterMix.getParamID(), 50.0f);
+        setActiveVoices(processor, 1);
+
+        const auto layout = processor.getChannelLayoutOfBus(false, 0);
+        const int left = layout.getChannelIndexForType(juce::AudioChannelSet::left);
+        juce::AudioBuffer<float> buffer(layout.size(), blockSize);
+        juce::MidiBuffer midi;
+        double worst = 0.0;
+        for (int block = 0; block < 64; ++block) {
+            buffer.clear();
+            processor.processBlock(buffer, midi);
+            for (int ch = 0; ch < layout.size(); ++ch) {
+                const float send = processor.getChannelSend(layout.getTypeOfChannel(ch));
+                for (int i = 0; i < blockSize; ++i)
+                    worst = std::max(worst, std::abs(static_cast<double>(buffer.getSample(ch, i))
+                                                     - send * static_cast<double>(buffer.getSample(left, i))));
+            }
+        }
+        processor.releaseResources();
+        return worst;
+    }
+
+    // Steps through every look-ahead setting on a prepared processor without
+    // calling prepareToPlay again, as Standalone and many hosts do. With the
+    // mix at 0 and the sidechain fully dry the output is the delayed input,
+    // so an impulse shows the delay. Returns the largest difference, in
+    // samples, of the delay or the reported latency from the step's length.
+    int lookaheadStepError(double sampleRate) {
+        SolfeggioProcessor processor;
+        const int blockSize = 512;
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+        setParameter(processor, Solfeggio::Params::autoMode.getParamID(), 0.0f);
+        setParameter(processor, Solfeggio::Params::masterMix.getParamID(), 0.0f);
+        setParameter(processor, Solfeggio::Params::scDryWet.getParamID(), 0.0f);
+
+        const auto& steps = SidechainCompressor::lookaheadStepsMs;
+        const int impulseAt = 100;
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        int worst = 0;
+        for (int step = static_cast<int>(steps.size()) - 1; step >= 0; --step) {
+            setParameter(processor, Solfeggio::Params::scLookahead.getParamID(), static_cast<float>(step));
+            const int expected = SidechainCompressor::lookaheadSamples(steps[static_cast<size_t>(step)], sampleRate);
+
+            int found = -1;
+            for (int block = 0; block < 8 && found < 0; ++block) {
+                buffer.clear();
+                if (block == 0)
+                    for (int ch = 0; ch < 2; ++ch)
+                        buffer.setSample(ch, impulseAt, 1.0f);
+                processor.processBlock(buffer, midi);
+                for (int i = 0; i < blockSize && found < 0; ++i)
+                    if (std::abs(buffer.getSample(0, i)) > 0.5f)
+                        found = block * blockSize + i - impulseAt;
+            }
+            worst = std::max({ worst, found < 0 ? 8 * blockSize : std::abs(found - expected),
+                               std::abs(processor.getLatencySamples() - expected) });
+        }
+        processor.releaseResources();
+        return worst;
+    }
+
+} // namespace
+
+// Needs a JUCE message manager (the APVTS runs a timer); main() provides one.
+void Bench::runProcessorBenchmarks() {
+    if (! beginSuite("SolfeggioProcessor", "processBlock() as a host calls it, stereo music input"))
+        return;
+
+    for (double sr : sampleRates) {
+        const auto music = makeMusic(sr, 10.0, 2);
+        juce::AudioBuffer<double> musicDouble;
+        musicDouble.makeCopyOf(music);
+
+        for (int blockSize : blockSizes) {
+            SolfeggioProcessor processor;
+            processor.setRateAndBufferSizeDetails(sr, blockSize);
+            processor.prepareToPlay(sr, blockSize);
+            Feeder feeder(music, blockSize);
+            juce::MidiBuffer midi;
+
+            setParameter(processor, Solfeggio::Params::autoMode.getParamID(), 1.0f);
+            report(run("processBlock", sr, blockSize, [&](int n) {
+                processor.processBlock(feeder.next(n), midi);
+            }), { { "mode", "auto" } });
+
+            setParameter(processor, Solfeggio::Params::autoMode.getParamID(), 0.0f);
+            for (int activeVoices : { 0, 1, 3, Solfeggio::NUM_FREQUENCIES }) {
+                setActiveVoices(processor, activeVoices);
+                report(run("processBlock", sr, blockSize, [&](int n) {
+                    processor.processBlock(feeder.next(n), midi);
+                }), { { "mode", "manual" }, { "activeVoices", activeVoices } });
+            }
+
+            // The native 64-bit path a double-precision host takes
+            Feeder doubleFeeder(musicDouble, blockSize);
+            setParameter(processor, Solfeggio::Params::autoMode.getParamID(), 1.0f);
+            report(run("processBlock (double)", sr, blockSize, [&](int n) {
+                processor.processBlock(doubleFeeder.next(n), midi);
+            }), { { "mode", "auto" } });
+
+            processor.releaseResources();
+        }
+    }
+
+    reportCheck("5.1 sends (C 0.25, Ls 0.5, LFE default) vs send x front left, max sample difference",
+                channelSendError(48000.0), "linear", atMost(1.0e-6));
+    reportCheck("look-ahead steps changed without prepareToPlay, delay and reported latency vs step, max error",
+                lookaheadStepError(48000.0), "samples", exactly(0.0));
+}
@@ -0,0 +1,406 @@
+#include "Benchmark.h"
+#include "SidechainCompressor.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+    struct CurveSettings {
+        float thresholdDb, ratio, kneeWidthDb, attackMs, releaseMs;
+    };
+
+    // The exact per-sample gain computer the gain table replaced:
+    // log10 + pow per sample, parameter atomics read per sample and the
+    // envelope coefficients recomputed with std::exp every block. Kept as the
+    // reference for both timing and accuracy.
+    struct ReferenceCompressor {
+        std::atomic<float> thresholdDb { -18.0f }, ratio { 4.0f }, kneeWidthDb { 6.0f };
+        std::atomic<float> attackMs { 10.0f }, releaseMs { 100.0f }, dryWet { 1.0f };
+
+        double sampleRate = 44100.0;
+        std::vector<juce::dsp::IIR::Filter<float>> keyFilters;
+        std::vector<float> envelopes;
+        float attackCoeff = 0.0f, releaseCoeff = 0.0f;
+        float* const* levelLog = nullptr;   // optional per-sample detector level in dB
+
+        void prepare(double sr, int numChannels) {
+            sampleRate = sr;
+            keyFilters.resize(static_cast<size_t>(numChannels));
+            for (auto& f : keyFilters) {
+                f.coefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass(sr, 800.0f, 1.5f);
+                f.reset();
+            }
+            envelopes.assign(static_cast<size_t>(numChannels), 0.0f);
+        }
+
+        float computeGainReduction(float levelDb) const {
+            float thresh = thresholdDb.load();
+            float r = ratio.load();
+            float knee = kneeWidthDb.load();
+            float halfKnee = knee * 0.5f;
+            float diff = levelDb - thresh;
+            if (diff <= -halfKnee) return 0.0f;
+            if (diff >= halfKnee) return diff * (1.0f - 1.0f / r);
+            float x = diff + halfKnee;
+            return (x * x) / (4.0f * knee) * (1.0f - 1.0f / r);
+        }
+
+        void process(float* const* channels, int numChannels, int numSamples) {
+            float wet = dryWet.load();
+            attackCoeff  = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * attackMs.load()  * 0.001f));
+            releaseCoeff = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * releaseMs.load() * 0.001f));
+
+            for (int ch = 0; ch < numChannels; ++ch) {
+                auto idx = static_cast<size_t>(ch);
+                float& env = envelopes[idx];
+                for (int i = 0; i < numSamples; ++i) {
+                    float& s = channels[ch][i];
+                    float level = std::abs(keyFilters[idx].processSample(s));
+                    float coeff = (level > env) ? attackCoeff : releaseCoeff;
+                    env += coeff * (level - env);
+                    float levelDb = juce::Decibels::gainToDecibels(env, -100.0f);
+                    if (levelLog != nullptr)
+                        levelLog[ch][i] = levelDb;
+                    float gainLin = juce::Decibels::decibelsToGain(-computeGainReduction(levelDb));
+                    s = s * (1.0f - wet) + (s * gainLin) * wet;
+                }
+            }
+        }
+    };
+
+    void configure(SidechainCompressor& c, const CurveSettings& s) {
+        c.setThresholdDb(s.thresholdDb);
+        c.setRatio(s.ratio);
+        c.setKneeWidthDb(s.kneeWidthDb);
+        c.setAttackMs(s.attackMs);
+        c.setReleaseMs(s.releaseMs);
+    }
+
+    void configure(ReferenceCompressor& c, const CurveSettings& s) {
+        c.thresholdDb.store(s.thresholdDb);
+        c.ratio.store(s.ratio);
+        c.kneeWidthDb.store(s.kneeWidthDb);
+        c.attackMs.store(s.attackMs);
+        c.releaseMs.store(s.releaseMs);
+    }
+
+    // Noise swept from -90 dBFS to +6 dBFS over `seconds`, two channels
+    // 12 dB apart so the channels sit on different parts of the curve.
+    juce::AudioBuffer<float> makeLevelSweep(double sampleRate, double seconds) {
+        const int numSamples = static_cast<int>(sampleRate * seconds);
+        juce::AudioBuffer<float> buffer(2, numSamples);
+
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+        for (int i = 0; i < numSamples; ++i) {
+            const float db = -90.0f + 96.0f * static_cast<float>(i) / static_cast<float>(numSamples);
+            const float amp = juce::Decibels::decibelsToGain(db);
+            buffer.getWritePointer(0)[i] = noise(rng) * amp;
+            buffer.getWritePointer(1)[i] = noise(rng) * amp * 0.25f;
+        }
+        return buffer;
+    }
+
+    // Max deviation of the applied gain from the reference, in dB. The
+    // reference curve steps by slope * knee / 4 at the top of the knee; the
+    // table interpolates across that step within one segment (1/32 octave),
+    // so frames whose level sits in that segment are left out.
+    double measureGainErrorDb(const CurveSettings& settings, double sampleRate, int blockSize) {
+        const auto input = makeLevelSweep(sampleRate, 10.0);
+        const int numSamples = input.getNumSamples();
+
+        juce::AudioBuffer<float> fast(2, numSamples), ref(2, numSamples), refLevelDb(2, numSamples);
+        for (int ch = 0; ch < 2; ++ch) {
+            juce::FloatVectorOperations::copy(fast.getWritePointer(ch), input.getReadPointer(ch), numSamples);
+            juce::FloatVectorOperations::copy(ref.getWritePointer(ch), input.getReadPointer(ch), numSamples);
+        }
+
+        SidechainCompressor comp;
+        configure(comp, settings);
+        comp.setDryWet(1.0f);
+        comp.setLinkMode(SidechainCompressor::LinkMode::Unlinked);
+        comp.prepare(sampleRate, blockSize, 2);
+
+        ReferenceCompressor reference;
+        configure(reference, settings);
+        reference.prepare(sampleRate, 2);
+
+        for (int pos = 0; pos < numSamples; pos += blockSize) {
+            const int n = juce::jmin(blockSize, numSamples - pos);
+            float* f[] = { fast.getWritePointer(0, pos), fast.getWritePointer(1, pos) };
+            float* r[] = { ref.getWritePointer(0, pos),  ref.getWritePointer(1, pos) };
+            float* l[] = { refLevelDb.getWritePointer(0, pos), refLevelDb.getWritePointer(1, pos) };
+            reference.levelLog = l;
+            comp.process(f, 2, n);
+            reference.process(r, 2, n);
+        }
+
+        const float kneeTopDb = settings.thresholdDb + settings.kneeWidthDb * 0.5f;
+        const float segmentDb = juce::Decibels::gainToDecibels(1.0f + 1.0f / 32.0f);
+
+        double maxErrorDb = 0.0;
+        for (int ch = 0; ch < 2; ++ch) {
+            for (int i = 0; i < numSamples; ++i) {
+                const double x = input.getSample(ch, i);
+                if (std::abs(x) < 1.0e-6)
+                    continue;
+                if (settings.kneeWidthDb > 0.0f && std::abs(refLevelDb.getSample(ch, i) - kneeTopDb) < segmentDb)
+                    continue;
+                const double gFast = fast.getSample(ch, i) / x;
+                const double gRef  = ref.getSample(ch, i) / x;
+                maxErrorDb = juce::jmax(maxErrorDb, std::abs(20.0 * std::log10(gFast / gRef)));
+            }
+        }
+        return maxErrorDb;
+    }
+
+    // Decaying 800 Hz bursts (the key filter's centre) twice a second, the
+    // kind of hit look-ahead is for; returns the loudest output sample after
+    // the first second
+    double burstPeakDb(double sampleRate, float lookaheadMs) {
+        const int numSamples = static_cast<int>(sampleRate * 4.0);
+        const int period = static_cast<int>(sampleRate * 0.5);
+        std::vector<float> signal(static_cast<size_t>(numSamples));
+        for (int i = 0; i < numSamples; ++i) {
+            const auto t = static_cast<float>(i % period / sampleRate);
+            signal[static_cast<size_t>(i)] = 0.9f * std::exp(-t * 120.0f)
+                                           * std::sin(juce::MathConstants<float>::twoPi * 800.0f * t);
+        }
+
+        SidechainCompressor comp;
+        comp.setDryWet(1.0f);
+        comp.setLinkMode(SidechainCompressor::LinkMode::Unlinked);
+        comp.setLookaheadMs(lookaheadMs);
+        comp.prepare(sampleRate, 256, 1);
+        for (int pos = 0; pos < numSamples; pos += 256) {
+            float* ch[] = { signal.data() + pos };
+            comp.process(ch, 1, juce::jmin(256, numSamples - pos));
+        }
+
+        float peak = 0.0f;
+        for (size_t i = static_cast<size_t>(sampleRate); i < signal.size(); ++i)
+            peak = juce::jmax(peak, std::abs(signal[i]));
+        return juce::Decibels::gainToDecibels(static_cast<double>(peak));
+    }
+
+    // Where an impulse comes out with the compressor fully dry, minus where
+    // the latency says it should
+    int lookaheadDelayError(double sampleRate, float lookaheadMs, int blockSize) {
+        const int latency = SidechainCompressor::lookaheadSamples(lookaheadMs, sampleRate);
+        std::vector<double> signal(static_cast<size_t>(latency + 4 * blockSize), 0.0);
+        signal[3] = 1.0;
+
+        SidechainCompressor comp;
+        comp.setDryWet(0.0f);
+        comp.setLookaheadMs(lookaheadMs);
+        comp.prepare(sampleRate, blockSize, 1);
+        for (size_t pos = 0; pos < signal.size(); pos += static_cast<size_t>(blockSize)) {
+            double* ch[] = { signal.data() + pos };
+            comp.process(ch, 1, juce::jmin(blockSize, static_cast<int>(signal.size() - pos)));
+        }
+
+        const auto found = std::find(signal.begin(), signal.end(), 1.0);
+        return static_cast<int>(found - signal.begin()) - 3 - latency;
+    }
+
+    // Gain the RMS detector applies to an 800 Hz tone just above threshold
+    // after `minutes` of full-scale noise and two seconds of silence, minus
+    // the gain a fresh compressor applies to the same silence and tone.
+    // Anything left in the running sums by the noise shows up here.
+    double rmsDriftDb(double sampleRate, double minutes) {
+        const int blockSize = 512;
+        const int settle = static_cast<int>(sampleRate * 2.0);
+        const int toneLength = static_cast<int>(sampleRate * 0.5);
+        std::vector<float> tail(static_cast<size_t>(settle + toneLength), 0.0f);
+        for (int i = 0; i < toneLength; ++i)
+            tail[static_cast<size_t>(settle + i)] = 0.2f * std::sin(juce::MathConstants<float>::twoPi * 800.0f
+                                                                    * static_cast<float>(i / sampleRate));
+
+        auto makeCompressor = [&] {
+            auto comp = std::make_unique<SidechainCompressor>();
+            comp->setDryWet(1.0f);
+            comp->setLinkMode(SidechainCompressor::LinkMode::Unlinked);
+            comp->setDetectorMode(SidechainCompressor::DetectorMode::Rms);
+            comp->prepare(sampleRate, blockSize, 1);
+            return comp;
+        };
+
+        auto runTail = [&](SidechainCompressor& comp) {
+            auto out = tail;
+            for (int pos = 0; pos < static_cast<int>(out.size()); pos += blockSize) {
+                float* ch[] = { out.data() + pos };
+                comp.process(ch, 1, juce::jmin(blockSize, static_cast<int>(out.size()) - pos));
+            }
+            return out;
+        };
+
+        auto worn = makeCompressor();
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+        std::vector<float> block(static_cast<size_t>(blockSize));
+        const auto noiseSamples = static_cast<juce::int64>(sampleRate * 60.0 * minutes);
+        for (juce::int64 pos = 0; pos < noiseSamples; pos += blockSize) {
+            for (auto& x : block)
+                x = noise(rng);
+            float* ch[] = { block.data() };
+            worn->process(ch, 1, blockSize);
+        }
+
+        const auto wornOut = runTail(*worn);
+        const auto freshOut = runTail(*makeCompressor());
+
+        double maxDiffDb = 0.0;
+        for (int i = settle + toneLength / 2; i < settle + toneLength; ++i) {
+            const auto a = std::abs(static_cast<double>(wornOut[static_cast<size_t>(i)]));
+            const auto b = std::abs(static_cast<double>(freshOut[static_cast<size_t>(i)]));
+            if (b > 1.0e-3)
+                maxDiffDb = juce::jmax(maxDiffDb, std::abs(20.0 * std::log10(a / b)));
+        }
+        return maxDiffDb;
+    }
+
+    // Gain on an 800 Hz tone after a second of loud noise unlinked, two
+    // seconds of silence linked and the switch back, minus the gain of a
+    // compressor left unlinked throughout. Per-channel envelopes left over
+    // from before linking show up here.
+    double linkSwitchErrorDb(double sampleRate) {
+        const int blockSize = 512;
+        const int noiseLength = static_cast<int>(sampleRate);
+        const int settle = static_cast<int>(sampleRate * 2.0);
+        const int toneLength = static_cast<int>(sampleRate * 0.5);
+        const int toneStart = noiseLength + settle;
+
+        juce::AudioBuffer<float> input(2, toneStart + toneLength);
+        input.clear();
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+        for (int ch = 0; ch < 2; ++ch) {
+            for (int i = 0; i < noiseLength; ++i)
+                input.setSample(ch, i, noise(rng));
+            for (int i = 0; i < toneLength; ++i)
+                input.setSample(ch, toneStart + i, 0.2f * std::sin(juce::MathConstants<float>::twoPi * 800.0f
+                                                                   * static_cast<float>(i / sampleRate)));
+        }
+
+        auto render = [&](bool switchLink) {
+            SidechainCompressor comp;
+            comp.setDryWet(1.0f);
+            comp.setLinkMode(SidechainCompressor::LinkMode::Unlinked);
+            comp.prepare(sampleRate, blockSize, 2);
+
+            auto out = input;
+            for (int pos = 0; pos < out.getNumSamples(); pos += blockSize) {
+                if (switchLink)
+                    comp.setLinkMode(pos >= noiseLength && pos < toneStart ? SidechainCompressor::LinkMode::LinkedMax
+                                                                           : SidechainCompressor::LinkMode::Unlinked);
+                float* ch[] = { out.getWritePointer(0, pos), out.getWritePointer(1, pos) };
+                comp.process(ch, 2, juce::jmin(blockSize, out.getNumSamples() - pos));
+            }
+            return out;
+        };
+
+        const auto switched = render(true);
+        const auto unlinked = render(false);
+
+        double maxDiffDb = 0.0;
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = toneStart; i < toneStart + toneLength; ++i) {
+                const auto a = std::abs(static_cast<double>(switched.getSample(ch, i)));
+                const auto b = std::abs(static_cast<double>(unlinked.getSample(ch, i)));
+                if (b > 1.0e-3)
+                    maxDiffDb = juce::jmax(maxDiffDb, std::abs(20.0 * std::log10(a / b)));
+            }
+        return maxDiffDb;
+    }
+
+} // namespace
+
+void Bench::runSidechainCompressorBenchmarks() {
+    if (! beginSuite("SidechainCompressor", "gain table vs reference log10/pow (stereo)"))
+        return;
+
+    const CurveSettings defaults { -18.0f, 4.0f, 6.0f, 10.0f, 100.0f };
+
+    for (double sr : sampleRates) {
+        for (int blockSize : blockSizes) {
+            const auto sweep = makeLevelSweep(sr, 1.0);
+            juce::AudioBuffer<float> work(2, blockSize);
+            int readPos = 0;
+
+            // Walks the sweep so both sides see the same mix of below-knee,
+            // knee and above-knee levels
+            auto nextBlock = [&](int n) {
+                if (readPos + n > sweep.getNumSamples())
+                    readPos = 0;
+                for (int ch = 0; ch < 2; ++ch)
+                    juce::FloatVectorOperations::copy(work.getWritePointer(ch), sweep.getReadPointer(ch, readPos), n);
+                readPos += n;
+                return work.getArrayOfWritePointers();
+            };
+
+            ReferenceCompressor reference;
+            configure(reference, defaults);
+            reference.prepare(sr, 2);
+            report(run("reference log10/pow", sr, blockSize, [&](int n) {
+                reference.process(nextBlock(n), 2, n);
+            }));
+
+            for (auto link : { SidechainCompressor::LinkMode::Unlinked, SidechainCompressor::LinkMode::LinkedMax }) {
+                for (float lookaheadMs : { 0.0f, 5.0f }) {
+                    SidechainCompressor comp;
+                    configure(comp, defaults);
+                    comp.setDryWet(1.0f);
+                    comp.setLinkMode(link);
+                    comp.setLookaheadMs(lookaheadMs);
+                    comp.prepare(sr, blockSize, 2);
+                    readPos = 0;
+                    report(run("SidechainCompressor", sr, blockSize, [&](int n) {
+                        comp.process(nextBlock(n), 2, n);
+                    }), { { "link", link == SidechainCompressor::LinkMode::Unlinked ? "unlinked" : "max" },
+                          { "lookaheadMs", lookaheadMs } });
+                }
+            }
+
+            SidechainCompressor rmsComp;
+            configure(rmsComp, defaults);
+            rmsComp.setDryWet(1.0f);
+            rmsComp.setDetectorMode(SidechainCompressor::DetectorMode::Rms);
+            rmsComp.prepare(sr, blockSize, 2);
+            readPos = 0;
+            report(run("SidechainCompressor", sr, blockSize, [&](int n) {
+                rmsComp.process(nextBlock(n), 2, n);
+            }), { { "link", "max" }, { "detector", "rms" } });
+        }
+    }
+
+    const CurveSettings curves[] = {
+        defaults,
+        { -40.0f,  2.0f, 12.0f,  1.0f,  50.0f },
+        { -30.0f, 20.0f,  0.0f,  5.0f, 300.0f },
+        { -96.0f,  4.0f, 12.0f, 10.0f, 100.0f },   // knee reaches the -100 dB floor
+    };
+
+    // The 20:1 hard knee is the worst case: the table rounds its corner off
+    // within one segment
+    for (const auto& c : curves)
+        for (int blockSize : { 1, 64, 512 })
+            reportCheck(juce::String::formatted("gain error, thr %.0f dB, ratio %.0f, knee %.0f dB, block %d",
+                                                static_cast<double>(c.thresholdDb), static_cast<double>(c.ratio),
+                                                static_cast<double>(c.kneeWidthDb), blockSize),
+                        measureGainErrorDb(c, 48000.0, blockSize), "dB", atMost(0.1));
+
+    for (float lookaheadMs : { 0.0f, 2.0f, 5.0f })
+        reportCheck("drum burst output peak (input -0.9 dBFS), look-ahead " + juce::String(lookaheadMs, 0) + " ms",
+                    burstPeakDb(48000.0, lookaheadMs), "dBFS");
+
+    reportCheck("RMS detector drift after 10 min of full-scale noise", rmsDriftDb(48000.0, 10.0), "dB", atMost(0.01));
+    reportCheck("gain error after unlinked -> linked -> unlinked", linkSwitchErrorDb(48000.0), "dB", atMost(0.01));
+
+    for (double sr : sampleRates)
+        for (float lookaheadMs : SidechainCompressor::lookaheadStepsMs)
+            reportCheck("look-ahead " + juce::String(lookaheadMs, 0) + " ms delay vs reported latency, "
+                            + juce::String(sr, 0) + " Hz",
+                        lookaheadDelayError(sr, lookaheadMs, 100), "samples", exactly(0.0));
+}
@@ -0,0 +1,75 @@
+#include "Benchmark.h"
+#include "SmartAutoEngine.h"
+#include <vector>
+
+namespace {
+
+    using Gains = std::array<float, Solfeggio::NUM_FREQUENCIES>;
+
+    // Target gains read every `traceStep` samples over `seconds` of audio,
+    // with the cycle clock advanced `blockSize` samples per call. The step
+    // is a multiple of every block size in the matrix, so all runs are
+    // compared at the same sample positions.
+    constexpr int traceStep = 4096;
+
+    std::vector<float> gainTrace(double sampleRate, int blockSize, float cycleTime, double seconds) {
+        SmartAutoEngine autoEngine;
+        autoEngine.prepare(sampleRate);
+        Gains gains {};
+
+        std::vector<float> trace;
+        const int numSteps = static_cast<int>(sampleRate * seconds) / traceStep;
+        for (int step = 0; step < numSteps; ++step) {
+            for (int n = 0; n < traceStep; n += blockSize)
+                autoEngine.getTargetGains(gains, cycleTime, 0.6f, blockSize);
+            trace.insert(trace.end(), gains.begin(), gains.end());
+        }
+        return trace;
+    }
+
+} // namespace
+
+void Bench::runSmartAutoEngineBenchmarks() {
+    if (! beginSuite("SmartAutoEngine", "band analysis + target gains per block"))
+        return;
+
+    for (double sr : sampleRates) {
+        const auto music = makeMusic(sr, 10.0, 1);
+
+        for (int blockSize : blockSizes) {
+            SmartAutoEngine autoEngine;
+            autoEngine.prepare(sr);
+            Feeder feeder(music, blockSize);
+            std::array<float, Solfeggio::NUM_FREQUENCIES> gains {};
+
+            report(run("analyzeBlock", sr, blockSize, [&](int n) {
+                autoEngine.analyzeBlock(feeder.next(n).getReadPointer(0), n);
+            }));
+
+            report(run("analyzeBlock + getTargetGains", sr, blockSize, [&](int n) {
+                autoEngine.analyzeBlock(feeder.next(n).getReadPointer(0), n);
+                autoEngine.getTargetGains(gains, 45.0f, 0.6f, n);
+            }));
+        }
+    }
+
+    // Cycle and crossfade timing must not depend on the host: every block
+    // size and sample rate has to land on the gains a one-sample clock gives.
+    // A 3 s cycle ends mid-crossfade, a 7 s one after it. No audio is
+    // analysed, so the profile (and with it the selection) stays fixed.
+    constexpr double matrixRates[]  = { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+    constexpr int    matrixBlocks[] = { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+
+    int mismatches = 0;
+    for (double sr : matrixRates)
+        for (float cycleTime : { 3.0f, 7.0f }) {
+            const auto reference = gainTrace(sr, 1, cycleTime, 30.0);
+            for (int blockSize : matrixBlocks) {
+                const auto trace = gainTrace(sr, blockSize, cycleTime, 30.0);
+                for (size_t i = 0; i < trace.size(); ++i)
+                    if (std::abs(trace[i] - reference[i]) > 1.0e-6f)
+                        ++mismatches;
+            }
+        }
+    reportCheck("target gains off the per-sample clock, blocks 16-4096, 44.1-192 kHz", mismatches, "values", exactly(0.0));
+}
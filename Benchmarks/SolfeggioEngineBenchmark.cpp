@@ -0,0 +1,120 @@
+#include "Benchmark.h"
+#include "SolfeggioEngine.h"
+
+namespace {
+
+    // Master mix as a host without sample-accurate automation delivers it:
+    // one value per 4096-sample block, following a 2 Hz sine
+    constexpr int hostBlock = 4096;
+
+    float hostMix(double sampleRate, int block) {
+        const double t = block * hostBlock / sampleRate;
+        return static_cast<float>(0.5 + 0.5 * std::sin(juce::MathConstants<double>::twoPi * 2.0 * t));
+    }
+
+    // The line the engine should follow through those values: block k's
+    // value is reached at the end of block k, starting from block k - 1's
+    float mixLine(double sampleRate, int endSample) {
+        const int block = (endSample - 1) / hostBlock;
+        const float from = hostMix(sampleRate, juce::jmax(0, block - 1));
+        const float to   = hostMix(sampleRate, block);
+        return from + (to - from) * (static_cast<float>(endSample - block * hostBlock) / static_cast<float>(hostBlock));
+    }
+
+    // One tone on silent input, rendered in blockSize blocks with the master
+    // mix mixAt(end sample of the block)
+    template <typename MixFn>
+    juce::AudioBuffer<float> renderMix(double sampleRate, int blockSize, int numSamples, MixFn&& mixAt) {
+        SolfeggioEngine engine;
+        engine.prepare(sampleRate, blockSize, 2);
+        engine.setSidechainParams(10.0f, 100.0f, 0.5f, SidechainCompressor::LinkMode::LinkedMax,
+                                  SidechainCompressor::DetectorMode::Peak);
+
+        std::array<float, Solfeggio::NUM_FREQUENCIES> manualGains {};
+        manualGains[5] = 0.5f;
+
+        juce::AudioBuffer<float> output(2, numSamples);
+        output.clear();
+        for (int pos = 0; pos < numSamples; pos += blockSize) {
+            const int length = juce::jmin(blockSize, numSamples - pos);
+            juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), 2, pos, length);
+            engine.process(block, false, 45.0f, 0.6f, manualGains, mixAt(pos + length));
+        }
+        return output;
+    }
+
+    // Largest sample difference between the per-block automation in
+    // 4096-sample blocks and its line handed over every controlInterval
+    // samples. A mix that only moved at block boundaries would be off by up
+    // to the size of a block's step.
+    double automationLineError(double sampleRate) {
+        const int numSamples = hostBlock * 24;
+        const auto host = renderMix(sampleRate, hostBlock, numSamples, [&](int end) {
+            return hostMix(sampleRate, (end - 1) / hostBlock);
+        });
+        const auto line = renderMix(sampleRate, SolfeggioEngine::controlInterval, numSamples, [&](int end) {
+            return mixLine(sampleRate, end);
+        });
+
+        double maxDiff = 0.0;
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                maxDiff = juce::jmax(maxDiff, std::abs(static_cast<double>(host.getSample(ch, i) - line.getSample(ch, i))));
+        return maxDiff;
+    }
+
+} // namespace
+
+void Bench::runSolfeggioEngineBenchmarks() {
+    if (! beginSuite("SolfeggioEngine", "full engine process(), stereo music input, then 1-12 channels"))
+        return;
+
+    constexpr int numChannels = 2;
+
+    for (double sr : sampleRates) {
+        const auto music = makeMusic(sr, 10.0, numChannels);
+
+        for (int blockSize : blockSizes) {
+            SolfeggioEngine engine;
+            engine.prepare(sr, blockSize, numChannels);
+            engine.setSidechainParams(10.0f, 100.0f, 0.5f, SidechainCompressor::LinkMode::LinkedMax,
+                                      SidechainCompressor::DetectorMode::Peak);
+            Feeder feeder(music, blockSize);
+
+            std::array<float, Solfeggio::NUM_FREQUENCIES> manualGains {};
+            report(run("process", sr, blockSize, [&](int n) {
+                engine.process(feeder.next(n), true, 45.0f, 0.6f, manualGains, 0.15f);
+            }), { { "mode", "auto" } });
+
+            for (int activeVoices : { 0, 1, 3, Solfeggio::NUM_FREQUENCIES }) {
+                for (size_t v = 0; v < manualGains.size(); ++v)
+                    manualGains[v] = static_cast<int>(v) < activeVoices ? 0.5f : 0.0f;
+
+                report(run("process", sr, blockSize, [&](int n) {
+                    engine.process(feeder.next(n), false, 45.0f, 0.6f, manualGains, 0.15f);
+                }), { { "mode", "manual" }, { "activeVoices", activeVoices } });
+            }
+        }
+    }
+
+    // Channel scaling: one shared render, one mix pass per channel
+    for (int channels : { 1, 2, 6, 12 }) {
+        constexpr double sr = 48000.0;
+        constexpr int blockSize = 256;
+        const auto music = makeMusic(sr, 10.0, channels);
+
+        SolfeggioEngine engine;
+        engine.prepare(sr, blockSize, channels);
+        engine.setSidechainParams(10.0f, 100.0f, 0.5f, SidechainCompressor::LinkMode::LinkedMax,
+                                  SidechainCompressor::DetectorMode::Peak);
+        Feeder feeder(music, blockSize);
+
+        std::array<float, Solfeggio::NUM_FREQUENCIES> manualGains {};
+        report(run("process", sr, blockSize, [&](int n) {
+            engine.process(feeder.next(n), true, 45.0f, 0.6f, manualGains, 0.15f);
+        }), { { "mode", "auto" }, { "channels", channels } });
+    }
+
+    reportCheck("master mix automation in 4096-sample blocks vs its line every 32 samples, max sample difference",
+                automationLineError(48000.0), "linear", atMost(1.0e-5));
+}
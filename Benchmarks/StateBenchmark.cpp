@@ -0,0 +1,136 @@
+#include "Benchmark.h"
+#include "SolfeggioProcessor.h"
+#include <memory>
+
+namespace {
+
+    constexpr int sessionInstances = 40;
+    constexpr int fuzzStates = 200;
+
+    // The pre-binary format: the APVTS tree as XML, as older builds saved it
+    juce::MemoryBlock xmlState(SolfeggioProcessor& processor) {
+        juce::MemoryBlock block;
+        if (auto xml = processor.apvts.copyState().createXml())
+            juce::AudioProcessor::copyXmlToBinary(*xml, block);
+        return block;
+    }
+
+    // Every parameter at a random legal value, plus a few channel sends
+    void randomise(SolfeggioProcessor& processor, std::mt19937& rng) {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (auto* p : processor.getParameters())
+            p->setValueNotifyingHost(unit(rng));
+
+        using CT = juce::AudioChannelSet::ChannelType;
+        for (auto type : { CT::left, CT::right, CT::centre, CT::LFE, CT::leftSurround })
+            if (unit(rng) < 0.5f)
+                processor.setChannelSend(type, unit(rng));
+    }
+
+    // Parameters / sends that differ between two instances
+    int countMismatches(SolfeggioProcessor& a, SolfeggioProcessor& b) {
+        int mismatches = 0;
+        const auto& pa = a.getParameters();
+        const auto& pb = b.getParameters();
+        for (int i = 0; i < pa.size(); ++i)
+            if (std::abs(pa[i]->getValue() - pb[i]->getValue()) > 1.0e-6f)
+                ++mismatches;
+
+        using CT = juce::AudioChannelSet::ChannelType;
+        for (auto type : { CT::left, CT::right, CT::centre, CT::LFE, CT::leftSurround })
+            if (a.getChannelSend(type) != b.getChannelSend(type))
+                ++mismatches;
+        return mismatches;
+    }
+
+    // Mean microseconds to load `state` into each of `sessionInstances`
+    // instances, the way a host opens a session
+    double sessionLoadUs(const juce::MemoryBlock& state) {
+        std::vector<std::unique_ptr<SolfeggioProcessor>> session;
+        for (int i = 0; i < sessionInstances; ++i)
+            session.push_back(std::make_unique<SolfeggioProcessor>());
+
+        const auto start = std::chrono::steady_clock::now();
+        for (auto& instance : session)
+            instance->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        return us / sessionInstances;
+    }
+
+} // namespace
+
+// Needs a JUCE message manager (the APVTS runs a timer); main() provides one.
+void Bench::runStateBenchmarks() {
+    if (! beginSuite("State", "session load, binary state vs the XML it replaces"))
+        return;
+
+    std::mt19937 rng(7);
+    SolfeggioProcessor source;
+    randomise(source, rng);
+
+    juce::MemoryBlock binary;
+    source.getStateInformation(binary);
+    const auto xml = xmlState(source);
+
+    reportCheck("state size, binary", static_cast<double>(binary.getSize()), "bytes");
+    reportCheck("state size, XML", static_cast<double>(xml.getSize()), "bytes");
+    reportCheck("load per instance, binary, " + juce::String(sessionInstances) + " instances", sessionLoadUs(binary), "us");
+    reportCheck("load per instance, XML, " + juce::String(sessionInstances) + " instances", sessionLoadUs(xml), "us");
+
+    {
+        const auto start = std::chrono::steady_clock::now();
+        juce::MemoryBlock block;
+        for (int i = 0; i < 1000; ++i)
+            source.getStateInformation(block);
+        reportCheck("save, binary", std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / 1000.0, "us");
+    }
+
+    // Round-trip fuzz: random states through both formats into a fresh
+    // instance; any differing parameter or send counts
+    int binaryMismatches = 0, xmlMismatches = 0;
+    for (int i = 0; i < fuzzStates; ++i) {
+        SolfeggioProcessor a, b, c;
+        randomise(a, rng);
+
+        juce::MemoryBlock block;
+        a.getStateInformation(block);
+        b.setStateInformation(block.getData(), static_cast<int>(block.getSize()));
+        binaryMismatches += countMismatches(a, b);
+
+        const auto oldBlock = xmlState(a);
+        c.setStateInformation(oldBlock.getData(), static_cast<int>(oldBlock.getSize()));
+        xmlMismatches += countMismatches(a, c);
+    }
+    reportCheck("round-trip mismatches, binary, " + juce::String(fuzzStates) + " random states", binaryMismatches, "values", exactly(0.0));
+    reportCheck("round-trip mismatches, XML fallback, " + juce::String(fuzzStates) + " random states", xmlMismatches, "values", exactly(0.0));
+
+    // Truncated, bit-flipped and padded blobs must be rejected whole (the
+    // length and checksum catch all three) and never crash
+    int outOfRange = 0, accepted = 0;
+    SolfeggioProcessor reference, target;
+    reference.setStateInformation(binary.getData(), static_cast<int>(binary.getSize()));
+    for (int i = 0; i < fuzzStates * 10; ++i) {
+        juce::MemoryBlock bad(binary);
+        auto* bytes = static_cast<juce::uint8*>(bad.getData());
+        switch (rng() % 3) {
+            case 0:  bad.setSize(rng() % bad.getSize()); break;
+            case 1:  bytes[rng() % bad.getSize()] ^= static_cast<juce::uint8>(1u << (rng() % 8)); break;
+            default: {
+                const juce::uint8 padding[] = { 0x00, 0xff, 0x53, 0x4c };
+                bad.append(padding, rng() % sizeof(padding) + 1);
+                break;
+            }
+        }
+
+        target.setStateInformation(binary.getData(), static_cast<int>(binary.getSize()));
+        target.setStateInformation(bad.getData(), static_cast<int>(bad.getSize()));
+        if (countMismatches(reference, target) > 0)
+            ++accepted;
+
+        for (auto* p : target.getParameters())
+            if (! (p->getValue() >= 0.0f && p->getValue() <= 1.0f))
+                ++outOfRange;
+    }
+    reportCheck("corrupted blobs that changed state, of " + juce::String(fuzzStates * 10), accepted, "blobs", exactly(0.0));
+    reportCheck("out-of-range values after corrupted blobs", outOfRange, "values", exactly(0.0));
+}
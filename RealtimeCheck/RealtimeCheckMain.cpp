@@ -0,0 +1,165 @@
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include "RealtimeGuard.h"
+#include "SolfeggioProcessor.h"
+
+// ============================================================================
+// SolfeggioRealtimeCheck — real-time safety check for processBlock
+// Responsibility: Drives SolfeggioProcessor the way a busy host and an open
+// editor would — varying block sizes, randomised automation from both the
+// audio and the message thread, spectrum frames consumed concurrently — with
+// every processBlock call wrapped in a RealtimeGuard, in stereo and 5.1 and
+// through both the float and the double-precision processBlock.
+// Exits non-zero if any allocation, blocking lock or syscall happened on the
+// audio thread.
+// ============================================================================
+namespace {
+
+    constexpr const char* usage =
+        "Usage: SolfeggioRealtimeCheck [options]\n"
+        "\n"
+        "      --blocks=<n>       processBlock calls per sample rate, layout and precision (default 20000)\n"
+        "      --max-block=<n>    prepared block size; calls vary from 1 to this (default 1024)\n"
+        "      --seed=<n>         random seed for block sizes and automation (default 1)\n"
+        "      --reports=<n>      print backtraces for the first n violations (default 10)\n"
+        "  -h, --help             show this text\n";
+
+    constexpr double sampleRates[] = { 44100.0, 48000.0, 96000.0 };
+
+    // Stereo, and 5.1 for the multichannel path (per-channel sends, LFE at 0)
+    juce::Array<juce::AudioChannelSet> layouts() {
+        return { juce::AudioChannelSet::stereo(), juce::AudioChannelSet::create5point1() };
+    }
+
+    struct Settings {
+        int blocks   = 20000;
+        int maxBlock = 1024;
+        unsigned int seed = 1;
+    };
+
+    // Host side of one run: everything outside the guard (filling the input,
+    // host automation between callbacks) is the host's business, everything
+    // inside processBlock is ours. SampleType picks the processBlock overload.
+    template <typename SampleType>
+    void runAudioThread(SolfeggioProcessor& processor, const Settings& settings, unsigned int seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_int_distribution<int> anySize(1, settings.maxBlock);
+
+        const auto& params = processor.getParameters();
+        std::uniform_int_distribution<int> anyParam(0, params.size() - 1);
+
+        const int numChannels = processor.getTotalNumOutputChannels();
+        juce::AudioBuffer<SampleType> buffer(numChannels, settings.maxBlock);
+        juce::MidiBuffer midi;
+
+        for (int block = 0; block < settings.blocks; ++block) {
+            // Mostly full blocks, with the odd short one as hosts do around loops
+            const int numSamples = unit(rng) < 0.75f ? settings.maxBlock : anySize(rng);
+            buffer.setSize(numChannels, numSamples, false, false, true);
+            for (int ch = 0; ch < numChannels; ++ch) {
+                auto* data = buffer.getWritePointer(ch);
+                for (int i = 0; i < numSamples; ++i)
+                    data[i] = static_cast<SampleType>(0.5f * (unit(rng) - 0.5f));
+            }
+
+            if (unit(rng) < 0.125f)
+                params[anyParam(rng)]->setValue(unit(rng));
+
+            RealtimeGuard::ScopedAudioThread guard;
+            processor.processBlock(buffer, midi);
+        }
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::ArgumentList args(argc, argv);
+    if (args.containsOption("--help|-h")) {
+        std::printf("%s", usage);
+        return 0;
+    }
+
+    Settings settings;
+    if (const auto v = args.removeValueForOption("--blocks"); v.isNotEmpty())
+        settings.blocks = juce::jmax(1, v.getIntValue());
+    if (const auto v = args.removeValueForOption("--max-block"); v.isNotEmpty())
+        settings.maxBlock = juce::jmax(1, v.getIntValue());
+    if (const auto v = args.removeValueForOption("--seed"); v.isNotEmpty())
+        settings.seed = static_cast<unsigned int>(v.getLargeIntValue());
+    if (const auto v = args.removeValueForOption("--reports"); v.isNotEmpty())
+        RealtimeGuard::setReportLimit(juce::jmax(0, v.getIntValue()));
+
+    if (! RealtimeGuard::selfTest()) {
+        std::fprintf(stderr, "SolfeggioRealtimeCheck: allocation/lock interception is not active "
+                             "(unsupported platform or link setup)\n");
+        return 2;
+    }
+
+    SolfeggioProcessor processor;
+    auto& spectrum = processor.engine.getSpectrum();
+    const auto& params = processor.getParameters();
+
+    std::mt19937 rng(settings.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_int_distribution<int> anyParam(0, params.size() - 1);
+
+    for (const auto& layout : layouts()) {
+        juce::AudioProcessor::BusesLayout buses;
+        buses.inputBuses.add(layout);
+        buses.outputBuses.add(layout);
+        if (! processor.setBusesLayout(buses)) {
+            std::fprintf(stderr, "SolfeggioRealtimeCheck: %s layout rejected\n", layout.getDescription().toRawUTF8());
+            return 2;
+        }
+
+        for (const double sampleRate : sampleRates) {
+            for (const bool doublePrecision : { false, true }) {
+                processor.setProcessingPrecision(doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                                 : juce::AudioProcessor::singlePrecision);
+                processor.setRateAndBufferSizeDetails(sampleRate, settings.maxBlock);
+                processor.prepareToPlay(sampleRate, settings.maxBlock);
+
+                // As if the editor were open: the analysis thread runs FFTs on what
+                // the audio thread pushes while this thread picks up finished frames.
+                spectrum.startAnalysis();
+
+                std::atomic<bool> audioDone { false };
+                std::thread audio([&, seed = rng()] {
+                    if (doublePrecision)
+                        runAudioThread<double>(processor, settings, seed);
+                    else
+                        runAudioThread<float>(processor, settings, seed);
+                    audioDone = true;
+                });
+
+                // Editor side: ~60 Hz frame pickup plus slider moves through the
+                // notifying path the GUI attachments use
+                while (! audioDone) {
+                    spectrum.fetchLatestFrame();
+                    if (unit(rng) < 0.5f)
+                        params[anyParam(rng)]->setValueNotifyingHost(unit(rng));
+                    juce::Thread::sleep(16);
+                }
+                audio.join();
+
+                spectrum.stopAnalysis();
+                processor.releaseResources();
+
+                std::printf("%-14s %7.0f Hz %-6s: %d blocks of up to %d samples, %d violation(s) so far\n",
+                            layout.getDescription().toRawUTF8(), sampleRate, doublePrecision ? "double" : "float",
+                            settings.blocks, settings.maxBlock, RealtimeGuard::getViolationCount());
+            }
+        }
+    }
+
+    const int violations = RealtimeGuard::getViolationCount();
+    std::printf("%s\n", violations == 0 ? "processBlock is real-time safe"
+                                        : "processBlock is NOT real-time safe (backtraces above)");
+    return violations == 0 ? 0 : 1;
+}
@@ -0,0 +1,285 @@
+#include "RealtimeGuard.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+    // Guard depth of the current thread. Plain int with static TLS, so reading
+    // it from inside malloc can never allocate.
+    thread_local int guardDepth = 0;
+
+    std::atomic<int> violations { 0 };
+    std::atomic<int> reportLimit { 10 };
+    std::atomic<int> reported { 0 };
+
+    // Not inlined, so the backtrace skip below always drops exactly flag() and
+    // the wrapper that called it
+    [[gnu::noinline]] void flag(const char* what) noexcept {
+        if (guardDepth == 0)
+            return;
+
+        // Reporting itself allocates and writes; unguard while it runs
+        const int depth = guardDepth;
+        guardDepth = 0;
+
+        violations.fetch_add(1, std::memory_order_relaxed);
+        if (reported.fetch_add(1, std::memory_order_relaxed) < reportLimit.load(std::memory_order_relaxed)) {
+            std::fprintf(stderr, "\nreal-time violation: %s on the audio thread\n", what);
+            void* frames[48];
+            const int numFrames = backtrace(frames, 48);
+            backtrace_symbols_fd(frames + 2, numFrames - 2, STDERR_FILENO);
+        }
+
+        guardDepth = depth;
+    }
+
+    // Looks up the next definition of `name` after this executable (i.e. libc's)
+    // on first use; the race on `cache` is benign, every thread stores the same value.
+    template <typename Fn>
+    Fn* next(Fn*& cache, const char* name) noexcept {
+        if (cache == nullptr)
+            cache = reinterpret_cast<Fn*>(dlsym(RTLD_NEXT, name));
+        return cache;
+    }
+
+} // namespace
+
+namespace RealtimeGuard {
+
+    ScopedAudioThread::ScopedAudioThread() noexcept { ++guardDepth; }
+    ScopedAudioThread::~ScopedAudioThread() noexcept { --guardDepth; }
+
+    int getViolationCount() noexcept { return violations.load(); }
+
+    void resetViolationCount() noexcept {
+        violations = 0;
+        reported = 0;
+    }
+
+    void setReportLimit(int limit) noexcept { reportLimit = limit; }
+
+    bool selfTest() {
+        const int before = violations.load();
+        const int limit  = reportLimit.exchange(0);   // expected, so keep it quiet
+
+        {
+            ScopedAudioThread guard;
+            void* volatile p = std::malloc(16);
+            std::free(p);
+        }
+        const bool caughtAllocation = violations.load() >= before + 2;
+
+        {
+            std::mutex m;
+            ScopedAudioThread guard;
+            std::lock_guard<std::mutex> lock(m);
+        }
+        const bool caughtLock = violations.load() >= before + 3;
+
+        violations = before;
+        reported   = 0;
+        reportLimit = limit;
+        return caughtAllocation && caughtLock;
+    }
+
+} // namespace RealtimeGuard
+
+// ============================================================================
+// Interposed entry points
+// The allocator is reached through glibc's __libc_* aliases rather than
+// dlsym, which may itself allocate before it has resolved anything.
+// ============================================================================
+extern "C" {
+
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void  __libc_free(void*);
+
+void* malloc(size_t size) noexcept {
+    flag("malloc");
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    flag("calloc");
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+    flag("realloc");
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) noexcept {
+    if (ptr != nullptr)
+        flag("free");
+    __libc_free(ptr);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+    flag("aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+    flag("memalign");
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size) noexcept {
+    flag("posix_memalign");
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+    *result = __libc_memalign(alignment, size);
+    return *result != nullptr || size == 0 ? 0 : ENOMEM;
+}
+
+// Blocking synchronisation. pthread_mutex_trylock is deliberately allowed:
+// a try-lock that gives up is the accepted audio-thread pattern.
+int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept {
+    static decltype(&pthread_mutex_lock) real = nullptr;
+    flag("pthread_mutex_lock");
+    return next(real, "pthread_mutex_lock")(mutex);
+}
+
+int pthread_rwlock_rdlock(pthread_rwlock_t* lock) noexcept {
+    static decltype(&pthread_rwlock_rdlock) real = nullptr;
+    flag("pthread_rwlock_rdlock");
+    return next(real, "pthread_rwlock_rdlock")(lock);
+}
+
+int pthread_rwlock_wrlock(pthread_rwlock_t* lock) noexcept {
+    static decltype(&pthread_rwlock_wrlock) real = nullptr;
+    flag("pthread_rwlock_wrlock");
+    return next(real, "pthread_rwlock_wrlock")(lock);
+}
+
+int pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex) {
+    static decltype(&pthread_cond_wait) real = nullptr;
+    flag("pthread_cond_wait");
+    return next(real, "pthread_cond_wait")(cond, mutex);
+}
+
+int pthread_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex, const timespec* abstime) {
+    static decltype(&pthread_cond_timedwait) real = nullptr;
+    flag("pthread_cond_timedwait");
+    return next(real, "pthread_cond_timedwait")(cond, mutex, abstime);
+}
+
+int sem_wait(sem_t* sem) {
+    static decltype(&sem_wait) real = nullptr;
+    flag("sem_wait");
+    return next(real, "sem_wait")(sem);
+}
+
+int sem_timedwait(sem_t* sem, const timespec* abstime) {
+    static decltype(&sem_timedwait) real = nullptr;
+    flag("sem_timedwait");
+    return next(real, "sem_timedwait")(sem, abstime);
+}
+
+// File I/O, sleeping and raw syscalls (futex waits from std::atomic::wait
+// and friends arrive through syscall())
+int open(const char* path, int flags, ...) {
+    static int (*real)(const char*, int, ...) = nullptr;
+    flag("open");
+    va_list args;
+    va_start(args, flags);
+    const auto mode = static_cast<mode_t>(va_arg(args, unsigned int));
+    va_end(args);
+    return next(real, "open")(path, flags, mode);
+}
+
+int openat(int dirfd, const char* path, int flags, ...) {
+    static int (*real)(int, const char*, int, ...) = nullptr;
+    flag("openat");
+    va_list args;
+    va_start(args, flags);
+    const auto mode = static_cast<mode_t>(va_arg(args, unsigned int));
+    va_end(args);
+    return next(real, "openat")(dirfd, path, flags, mode);
+}
+
+int close(int fd) {
+    static decltype(&close) real = nullptr;
+    flag("close");
+    return next(real, "close")(fd);
+}
+
+ssize_t read(int fd, void* buffer, size_t count) {
+    static decltype(&read) real = nullptr;
+    flag("read");
+    return next(real, "read")(fd, buffer, count);
+}
+
+ssize_t write(int fd, const void* buffer, size_t count) {
+    static decltype(&write) real = nullptr;
+    flag("write");
+    return next(real, "write")(fd, buffer, count);
+}
+
+void* mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset) noexcept {
+    static decltype(&mmap) real = nullptr;
+    flag("mmap");
+    return next(real, "mmap")(addr, length, prot, flags, fd, offset);
+}
+
+int munmap(void* addr, size_t length) noexcept {
+    static decltype(&munmap) real = nullptr;
+    flag("munmap");
+    return next(real, "munmap")(addr, length);
+}
+
+int nanosleep(const timespec* duration, timespec* remaining) {
+    static decltype(&nanosleep) real = nullptr;
+    flag("nanosleep");
+    return next(real, "nanosleep")(duration, remaining);
+}
+
+int clock_nanosleep(clockid_t clock, int flags, const timespec* request, timespec* remaining) {
+    static decltype(&clock_nanosleep) real = nullptr;
+    flag("clock_nanosleep");
+    return next(real, "clock_nanosleep")(clock, flags, request, remaining);
+}
+
+int usleep(useconds_t microseconds) {
+    static decltype(&usleep) real = nullptr;
+    flag("usleep");
+    return next(real, "usleep")(microseconds);
+}
+
+int sched_yield() noexcept {
+    static decltype(&sched_yield) real = nullptr;
+    flag("sched_yield");
+    return next(real, "sched_yield")();
+}
+
+long syscall(long number, ...) noexcept {
+    static long (*real)(long, ...) = nullptr;
+    flag("syscall");
+    va_list args;
+    va_start(args, number);
+    long a[6];
+    for (auto& arg : a)
+        arg = va_arg(args, long);
+    va_end(args);
+    return next(real, "syscall")(number, a[0], a[1], a[2], a[3], a[4], a[5]);
+}
+
+} // extern "C"
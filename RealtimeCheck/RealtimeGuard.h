@@ -0,0 +1,41 @@
+#pragma once
+
+// ============================================================================
+// RealtimeGuard
+// Responsibility: Flags real-time-unsafe calls made from a guarded scope on
+// the audio thread — heap allocation and release, blocking locks and waits,
+// and the file / sleep / raw syscall entry points — and prints a backtrace
+// for each one.
+//
+// Detection works by symbol interposition: RealtimeGuard.cpp defines malloc,
+// pthread_mutex_lock, write, ... in the executable itself, so every call that
+// goes through the dynamic linker lands there first. Outside a guarded scope
+// the wrappers forward straight to libc. Linux/glibc only.
+// ============================================================================
+namespace RealtimeGuard {
+
+    // Marks the calling thread as "inside the audio callback" for its lifetime.
+    // Scopes nest; only the calling thread is affected.
+    class ScopedAudioThread {
+    public:
+        ScopedAudioThread() noexcept;
+        ~ScopedAudioThread() noexcept;
+
+        ScopedAudioThread(const ScopedAudioThread&) = delete;
+        ScopedAudioThread& operator=(const ScopedAudioThread&) = delete;
+    };
+
+    // Total violations seen since start-up (or the last reset)
+    int getViolationCount() noexcept;
+    void resetViolationCount() noexcept;
+
+    // Backtraces are printed for the first `limit` violations only; later
+    // ones are still counted
+    void setReportLimit(int limit) noexcept;
+
+    // Deliberately allocates and locks inside a guard and checks both were
+    // caught, so a broken interposition cannot pass as a clean run.
+    // Leaves the violation count as it found it.
+    bool selfTest();
+
+} // namespace RealtimeGuard
@@ -0,0 +1,108 @@
+#include "OfflineRenderer.h"
+
+OfflineRenderer::OfflineRenderer(juce::AudioProcessor& processorToUse)
+    : processor(processorToUse)
+{
+    formats.registerBasicFormats();
+}
+
+juce::String OfflineRenderer::getReadableWildcard() {
+    juce::AudioFormatManager basicFormats;
+    basicFormats.registerBasicFormats();
+    return basicFormats.getWildcardForAllFormats();
+}
+
+juce::Result OfflineRenderer::render(const juce::File& input, const juce::File& output, const Settings& settings) {
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(input));
+    if (reader == nullptr)
+        return juce::Result::fail("cannot read " + input.getFullPathName());
+
+    // Mono and stereo files run on a stereo bus; anything wider runs on the
+    // file's own layout (its WAVE channel mask, else the standard set for
+    // that channel count)
+    const int sourceChannels = static_cast<int>(reader->numChannels);
+    auto layout = juce::AudioChannelSet::stereo();
+    if (sourceChannels > 2) {
+        layout = reader->getChannelLayout();
+        if (layout.size() != sourceChannels)
+            layout = juce::AudioChannelSet::canonicalChannelSet(sourceChannels);
+        if (layout.size() != sourceChannels)
+            layout = juce::AudioChannelSet::discreteChannels(sourceChannels);
+    }
+    if (! processor.setChannelLayoutOfBus(true, 0, layout) || ! processor.setChannelLayoutOfBus(false, 0, layout))
+        return juce::Result::fail("the processor does not support " + juce::String(sourceChannels)
+                                  + " channels (" + layout.getDescription() + ")");
+    const int busChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+
+    auto* format = formats.findFormatForFileExtension(output.getFileExtension());
+    if (format == nullptr)
+        return juce::Result::fail("no writer for " + output.getFileExtension() + " files");
+
+    const int bitDepth = settings.bitDepth > 0 ? settings.bitDepth : static_cast<int>(reader->bitsPerSample);
+    if (! format->getPossibleBitDepths().contains(bitDepth))
+        return juce::Result::fail(format->getFormatName() + " cannot be written at " + juce::String(bitDepth) + " bits");
+
+    if (! output.getParentDirectory().createDirectory())
+        return juce::Result::fail("cannot create " + output.getParentDirectory().getFullPathName());
+
+    juce::TemporaryFile temp(output);
+    std::unique_ptr<juce::OutputStream> stream(temp.getFile().createOutputStream());
+    if (stream == nullptr)
+        return juce::Result::fail("cannot write " + temp.getFile().getFullPathName());
+
+    const double sampleRate = reader->sampleRate;
+    // The output keeps the source's layout (and so its channel mask)
+    const auto outputLayout = sourceChannels > 2 ? layout : juce::AudioChannelSet::canonicalChannelSet(sourceChannels);
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), sampleRate, outputLayout,
+                                                                            bitDepth, reader->metadataValues, 0));
+    if (writer == nullptr)
+        return juce::Result::fail("cannot create a " + format->getFormatName() + " writer");
+    stream.release();   // owned by the writer now
+
+    const int blockSize = juce::jmax(1, settings.blockSize);
+    processor.setNonRealtime(true);
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    // Feed `latency` extra samples of silence and drop the same number from
+    // the start, so output sample n corresponds to input sample n.
+    const juce::int64 length  = reader->lengthInSamples;
+    const juce::int64 latency = processor.getLatencySamples();
+
+    juce::AudioBuffer<float> buffer(busChannels, blockSize);
+    juce::MidiBuffer midi;
+    juce::int64 fed = 0, readPos = 0, written = 0;
+    bool ok = true;
+
+    while (ok && fed < length + latency) {
+        const int numSamples = static_cast<int>(juce::jmin<juce::int64>(blockSize, length + latency - fed));
+        buffer.setSize(busChannels, numSamples, false, false, true);
+        buffer.clear();
+
+        // A mono source is read into both channels of a stereo bus
+        const int fromFile = static_cast<int>(juce::jlimit<juce::int64>(0, numSamples, length - readPos));
+        if (fromFile > 0)
+            reader->read(&buffer, 0, fromFile, readPos, true, true);
+        readPos += fromFile;
+
+        processor.processBlock(buffer, midi);
+
+        const int skip = static_cast<int>(juce::jlimit<juce::int64>(0, numSamples, latency - fed));
+        const int keep = static_cast<int>(juce::jmin<juce::int64>(numSamples - skip, length - written));
+        if (ok && keep > 0)
+            ok = writer->writeFromAudioSampleBuffer(buffer, skip, keep);
+
+        written += juce::jmax(0, keep);
+        fed     += numSamples;
+    }
+
+    processor.releaseResources();
+    writer.reset();
+
+    if (! ok)
+        return juce::Result::fail("write failed part-way through " + output.getFileName());
+    if (! temp.overwriteTargetFileWithTemporary())
+        return juce::Result::fail("cannot replace " + output.getFullPathName());
+
+    return juce::Result::ok();
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <JuceHeader.h>
+
+// ============================================================================
+// OfflineRenderer
+// Responsibility: Streams one audio file through an AudioProcessor and writes
+// the result, block by block, without holding the file in memory.
+//
+// One renderer owns one processor (and its own AudioFormatManager), so a
+// worker thread can render files back to back with no shared state. The
+// processor is prepared per file at the file's sample rate and channel
+// layout (surround files run on their own layout), run non-realtime, and its
+// reported latency is trimmed so output lines up with the input.
+// ============================================================================
+class OfflineRenderer {
+public:
+    struct Settings {
+        int blockSize = 512;
+        int bitDepth  = 0;   // 0 = keep the source's bit depth
+    };
+
+    explicit OfflineRenderer(juce::AudioProcessor& processorToUse);
+
+    // Renders `input` into `output`; the output format follows its extension.
+    // The file is written to a temporary sibling and moved into place only
+    // once complete, so a failed render never leaves a truncated output.
+    juce::Result render(const juce::File& input, const juce::File& output, const Settings& settings);
+
+    // File patterns the basic formats can read, e.g. "*.wav;*.flac;*.aiff"
+    static juce::String getReadableWildcard();
+
+private:
+    juce::AudioProcessor& processor;
+    juce::AudioFormatManager formats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
@@ -0,0 +1,252 @@
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include "OfflineRenderer.h"
+#include "SolfeggioProcessor.h"
+
+// ============================================================================
+// SolfeggioRender — headless batch renderer
+// Responsibility: Command-line front end for OfflineRenderer. Collects input
+// files, configures one SolfeggioProcessor per worker thread from a preset
+// and/or --set overrides, and renders the files in parallel.
+// ============================================================================
+namespace {
+
+    constexpr const char* usage =
+        "Usage: SolfeggioRender [options] <file or directory>...\n"
+        "\n"
+        "  -o, --output-dir=<dir>   write renders here (default: next to each input,\n"
+        "                           named <name>_solfeggio.<ext>)\n"
+        "  -f, --format=<ext>       output format: wav, flac, aiff (default: input's)\n"
+        "  -b, --block-size=<n>     processing block size in samples (default 512)\n"
+        "      --bits=<n>           output bit depth (default: input's)\n"
+        "  -p, --preset=<file>      plugin state to load: XML or a saved state blob\n"
+        "  -s, --set=<id>=<value>   set a parameter, e.g. --set=masterMix=30;\n"
+        "                           repeatable, applied after the preset\n"
+        "      --send=<ch>=<0..1>   Solfeggio send of a channel type, by its short\n"
+        "                           name (L, R, C, Lfe, Ls, Rs, ...); repeatable.\n"
+        "                           Unset types send 1, except Lfe (0)\n"
+        "  -j, --jobs=<n>           worker threads (default: number of cores)\n"
+        "      --overwrite          replace existing output files\n"
+        "      --profile            print per-stage DSP timings after each file\n"
+        "      --list-params        print parameter IDs and ranges, then exit\n"
+        "  -h, --help               show this text\n";
+
+    struct Job {
+        juce::File input, output;
+    };
+
+    // Plain numbers are taken as real parameter values (Hz gain 0-1, masterMix
+    // 0-100, ...); anything else goes through the parameter's own text parser,
+    // so choices can be given by name ("Linked (Mean)") and bools as on/off.
+    juce::Result setParameter(juce::AudioProcessor& processor, const juce::String& id, const juce::String& text) {
+        for (auto* p : processor.getParameters()) {
+            auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(p);
+            if (ranged == nullptr || ranged->getParameterID() != id)
+                continue;
+
+            const bool numeric = text.trim().containsOnly("-+.0123456789") && text.trim().isNotEmpty();
+            ranged->setValueNotifyingHost(numeric ? ranged->convertTo0to1(text.getFloatValue())
+                                                  : ranged->getValueForText(text));
+            return juce::Result::ok();
+        }
+        return juce::Result::fail("unknown parameter '" + id + "' (see --list-params)");
+    }
+
+    juce::Result loadPreset(SolfeggioProcessor& processor, const juce::File& file) {
+        if (! file.existsAsFile())
+            return juce::Result::fail("preset not found: " + file.getFullPathName());
+
+        if (auto xml = juce::parseXML(file)) {
+            if (! xml->hasTagName(processor.apvts.state.getType()))
+                return juce::Result::fail("preset is not a " + juce::String(JucePlugin_Name) + " state");
+            processor.apvts.replaceState(juce::ValueTree::fromXml(*xml));
+            return juce::Result::ok();
+        }
+
+        // Not XML: treat it as a getStateInformation() blob saved by a host
+        juce::MemoryBlock data;
+        if (! file.loadFileAsData(data) || data.getSize() == 0)
+            return juce::Result::fail("cannot read preset " + file.getFullPathName());
+        processor.setStateInformation(data.getData(), static_cast<int>(data.getSize()));
+        return juce::Result::ok();
+    }
+
+    juce::Result setSend(SolfeggioProcessor& processor, const juce::String& name, const juce::String& text) {
+        const auto type = juce::AudioChannelSet::getChannelTypeFromAbbreviation(name);
+        if (type == juce::AudioChannelSet::unknown)
+            return juce::Result::fail("unknown channel type '" + name + "'");
+
+        const auto value = text.getFloatValue();
+        if (! text.trim().containsOnly(".0123456789") || text.trim().isEmpty() || value > 1.0f)
+            return juce::Result::fail("send for " + name + " must be 0..1, got '" + text + "'");
+
+        processor.setChannelSend(type, value);
+        return juce::Result::ok();
+    }
+
+    void listParameters(juce::AudioProcessor& processor) {
+        for (auto* p : processor.getParameters()) {
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(p)) {
+                const auto& range = ranged->getNormalisableRange();
+                std::printf("%-16s %-18s %g .. %g  (default %s)\n",
+                            ranged->getParameterID().toRawUTF8(), ranged->getName(64).toRawUTF8(),
+                            static_cast<double>(range.start), static_cast<double>(range.end),
+                            ranged->getText(ranged->getDefaultValue(), 64).toRawUTF8());
+            }
+        }
+    }
+
+    juce::File outputFileFor(const juce::File& input, const juce::File& outputDir, const juce::String& extension) {
+        const auto ext = extension.isNotEmpty() ? "." + extension.trimCharactersAtStart(".")
+                                                : input.getFileExtension();
+        if (outputDir != juce::File())
+            return outputDir.getChildFile(input.getFileNameWithoutExtension() + ext);
+        return input.getSiblingFile(input.getFileNameWithoutExtension() + "_solfeggio" + ext);
+    }
+
+    int fail(const juce::String& message) {
+        std::fprintf(stderr, "SolfeggioRender: %s\n", message.toRawUTF8());
+        return 1;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // APVTS runs a timer, so the message manager must exist before any
+    // processor is built; all processors are built here on the main thread.
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h") || args.size() == 0) {
+        std::printf("%s", usage);
+        return 0;
+    }
+
+    if (args.removeOptionIfFound("--list-params")) {
+        SolfeggioProcessor processor;
+        listParameters(processor);
+        return 0;
+    }
+
+    const bool overwrite = args.removeOptionIfFound("--overwrite");
+    const bool profile   = args.removeOptionIfFound("--profile");
+    const auto outputDirArg = args.removeValueForOption("--output-dir|-o");
+    const auto formatArg    = args.removeValueForOption("--format|-f");
+    const auto presetArg    = args.removeValueForOption("--preset|-p");
+    const auto blockArg     = args.removeValueForOption("--block-size|-b");
+    const auto bitsArg      = args.removeValueForOption("--bits");
+    const auto jobsArg      = args.removeValueForOption("--jobs|-j");
+
+    juce::StringArray overrides, sends;
+    while (args.containsOption("--set|-s"))
+        overrides.add(args.removeValueForOption("--set|-s"));
+    while (args.containsOption("--send"))
+        sends.add(args.removeValueForOption("--send"));
+
+    OfflineRenderer::Settings settings;
+    settings.blockSize = blockArg.isNotEmpty() ? blockArg.getIntValue() : settings.blockSize;
+    settings.bitDepth  = bitsArg.getIntValue();
+    if (settings.blockSize <= 0)
+        return fail("block size must be positive");
+
+    const int numWorkers = jobsArg.isNotEmpty() ? juce::jmax(1, jobsArg.getIntValue())
+                                                : juce::jmax(1, juce::SystemStats::getNumCpus());
+    const auto outputDir = outputDirArg.isNotEmpty() ? juce::File::getCurrentWorkingDirectory().getChildFile(outputDirArg)
+                                                     : juce::File();
+
+    // Collect inputs; directories are searched recursively for readable files
+    const auto wildcard = OfflineRenderer::getReadableWildcard();
+    std::vector<Job> jobs;
+    for (const auto& arg : args.arguments) {
+        if (arg.isOption())
+            return fail("unknown option " + arg.text);
+
+        const auto path = arg.resolveAsFile();
+        juce::Array<juce::File> inputs;
+        if (path.isDirectory())
+            inputs = path.findChildFiles(juce::File::findFiles, true, wildcard);
+        else if (path.existsAsFile())
+            inputs.add(path);
+        else
+            return fail("no such file or directory: " + path.getFullPathName());
+
+        for (const auto& input : inputs) {
+            const auto output = outputFileFor(input, outputDir, formatArg);
+            if (output == input)
+                return fail("output would overwrite its input: " + input.getFullPathName());
+            if (output.exists() && ! overwrite) {
+                std::printf("skip   %s (exists, use --overwrite)\n", output.getFullPathName().toRawUTF8());
+                continue;
+            }
+            jobs.push_back({ input, output });
+        }
+    }
+
+    if (jobs.empty()) {
+        std::printf("nothing to render\n");
+        return 0;
+    }
+
+    // One fully configured processor per worker
+    const int numProcessors = juce::jmin(numWorkers, static_cast<int>(jobs.size()));
+    std::vector<std::unique_ptr<SolfeggioProcessor>> processors;
+    for (int w = 0; w < numProcessors; ++w) {
+        auto processor = std::make_unique<SolfeggioProcessor>();
+
+        if (presetArg.isNotEmpty())
+            if (auto r = loadPreset(*processor, juce::File::getCurrentWorkingDirectory().getChildFile(presetArg)); r.failed())
+                return fail(r.getErrorMessage());
+
+        for (const auto& o : overrides) {
+            if (! o.containsChar('='))
+                return fail("--set expects <id>=<value>, got '" + o + "'");
+            if (auto r = setParameter(*processor, o.upToFirstOccurrenceOf("=", false, false).trim(),
+                                      o.fromFirstOccurrenceOf("=", false, false).trim()); r.failed())
+                return fail(r.getErrorMessage());
+        }
+
+        for (const auto& s : sends) {
+            if (! s.containsChar('='))
+                return fail("--send expects <channel>=<value>, got '" + s + "'");
+            if (auto r = setSend(*processor, s.upToFirstOccurrenceOf("=", false, false).trim(),
+                                 s.fromFirstOccurrenceOf("=", false, false).trim()); r.failed())
+                return fail(r.getErrorMessage());
+        }
+        processors.push_back(std::move(processor));
+    }
+
+    // Workers pull the next file until the list is exhausted
+    std::atomic<size_t> nextJob { 0 };
+    std::atomic<int> failures { 0 };
+    std::vector<std::thread> workers;
+
+    for (auto& processor : processors) {
+        workers.emplace_back([&, p = processor.get()] {
+            OfflineRenderer renderer(*p);
+            for (size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+                const auto& job = jobs[i];
+                const auto result = renderer.render(job.input, job.output, settings);
+                if (result.wasOk()) {
+                    juce::String line = "ok     " + job.output.getFullPathName() + "\n";
+                    if (profile)
+                        line << EngineProfiler::describe(p->engine.getProfiler().getSnapshot().session);
+                    std::printf("%s", line.toRawUTF8());
+                } else {
+                    ++failures;
+                    std::fprintf(stderr, "failed %s: %s\n", job.input.getFullPathName().toRawUTF8(),
+                                 result.getErrorMessage().toRawUTF8());
+                }
+            }
+        });
+    }
+
+    for (auto& w : workers)
+        w.join();
+
+    std::printf("%d of %d file(s) rendered\n", static_cast<int>(jobs.size()) - failures.load(),
+                static_cast<int>(jobs.size()));
+    return failures.load() == 0 ? 0 : 1;
+}
@@ -37,11 +37,23 @@ namespace Solfeggio {
         inline juce::ParameterID scAttack    { "scAttack",    1 };
         inline juce::ParameterID scRelease   { "scRelease",   1 };
         inline juce::ParameterID scDryWet    { "scDryWet",    1 };
+        inline juce::ParameterID scLink      { "scLink",      1 };
+        inline juce::ParameterID scLookahead { "scLookahead", 1 };
+        inline juce::ParameterID scDetector  { "scDetector",  1 };
 
         inline juce::String getGainID(float freq) { return juce::String(freq, 0) + "Hz_Gain"; }
         inline juce::String getOnID  (float freq)  { return juce::String(freq, 0) + "Hz_On";   }
     }
 
+    // -------------------------------------------------------------------------
+    // Non-parameter state stored alongside the parameters
+    // -------------------------------------------------------------------------
+    namespace State {
+        // Per-channel Solfeggio sends, one property per channel type
+        // (abbreviated name, e.g. "LFE") so they survive layout changes
+        inline const juce::Identifier channelSends { "ChannelSends" };
+    }
+
     // -------------------------------------------------------------------------
     // UI layout constants — avoids magic numbers in resized() calls
     // -------------------------------------------------------------------------
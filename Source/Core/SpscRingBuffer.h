@@ -0,0 +1,52 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+// ============================================================================
+// SpscRingBuffer
+// Responsibility: Lock-free single-producer / single-consumer sample queue.
+// Built on juce::AbstractFifo; storage is allocated once at construction so
+// neither side ever allocates. When full, push() drops what does not fit
+// rather than blocking the producer (the audio thread).
+// ============================================================================
+template <typename T>
+class SpscRingBuffer {
+public:
+    explicit SpscRingBuffer(int capacity)
+        : fifo(capacity), storage(static_cast<size_t>(capacity)) {}
+
+    // Producer side — returns the number of items actually queued
+    int push(const T* data, int numItems) noexcept {
+        const auto scope = fifo.write(juce::jmin(numItems, fifo.getFreeSpace()));
+        copyIn(data, scope.startIndex1, scope.blockSize1);
+        copyIn(data + scope.blockSize1, scope.startIndex2, scope.blockSize2);
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    // Consumer side — returns the number of items actually dequeued.
+    // A null destination discards them.
+    int pop(T* dest, int numItems) noexcept {
+        const auto scope = fifo.read(juce::jmin(numItems, fifo.getNumReady()));
+        if (dest != nullptr) {
+            copyOut(dest, scope.startIndex1, scope.blockSize1);
+            copyOut(dest + scope.blockSize1, scope.startIndex2, scope.blockSize2);
+        }
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    int getNumReady() const noexcept { return fifo.getNumReady(); }
+    int getCapacity() const noexcept { return fifo.getTotalSize() - 1; }
+
+private:
+    void copyIn(const T* src, int start, int count) noexcept {
+        std::copy(src, src + count, storage.begin() + start);
+    }
+    void copyOut(T* dest, int start, int count) const noexcept {
+        std::copy(storage.begin() + start, storage.begin() + start + count, dest);
+    }
+
+    juce::AbstractFifo fifo;
+    std::vector<T>     storage;
+
+    JUCE_DECLARE_NON_COPYABLE(SpscRingBuffer)
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <atomic>
+
+// ============================================================================
+// TripleBuffer
+// Responsibility: Wait-free hand-off of the latest complete value from one
+// writer thread to one reader thread. The writer fills its private slot and
+// publishes it; the reader picks up the newest published slot. Neither side
+// ever sees a half-written value, and neither side blocks.
+// ============================================================================
+template <typename T>
+class TripleBuffer {
+public:
+    // Writer side: fill getWriteBuffer(), then publish()
+    T& getWriteBuffer() noexcept { return slots[static_cast<size_t>(writeIndex)]; }
+
+    void publish() noexcept {
+        writeIndex = middle.exchange(writeIndex | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Reader side: returns true if a newer value was picked up
+    bool fetch() noexcept {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0)
+            return false;
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const T& getReadBuffer() const noexcept { return slots[static_cast<size_t>(readIndex)]; }
+
+private:
+    static constexpr int indexMask = 0x3;
+    static constexpr int freshBit  = 0x4;
+
+    std::array<T, 3> slots {};
+    int writeIndex = 0;
+    int readIndex  = 1;
+    std::atomic<int> middle { 2 };
+};
@@ -0,0 +1,54 @@
+#include "BandEnergyAnalyser.h"
+#include "SimdLanes.h"
+
+static_assert(BandEnergyAnalyser::maxBands == Simd::Float4::width, "one band per SIMD lane");
+
+BandEnergyAnalyser::BandEnergyAnalyser() {}
+
+void BandEnergyAnalyser::setBand(int band, const juce::dsp::IIR::Coefficients<float>& coeffs) {
+    jassert(band >= 0 && band < maxBands);
+    jassert(coeffs.getFilterOrder() == 2);
+
+    const auto* c = coeffs.getRawCoefficients();
+    const auto idx = static_cast<size_t>(band);
+    b0[idx] = c[0];
+    b1[idx] = c[1];
+    b2[idx] = c[2];
+    a1[idx] = c[3];
+    a2[idx] = c[4];
+}
+
+void BandEnergyAnalyser::reset() {
+    z1.fill(0.0f);
+    z2.fill(0.0f);
+}
+
+template <typename SampleType>
+std::array<float, BandEnergyAnalyser::maxBands> BandEnergyAnalyser::process(const SampleType* data,
+                                                                            int numSamples) noexcept {
+    using Simd::Float4;
+    const auto cb0 = Float4::load(b0.data()), cb1 = Float4::load(b1.data()), cb2 = Float4::load(b2.data());
+    const auto ca1 = Float4::load(a1.data()), ca2 = Float4::load(a2.data());
+
+    auto s1 = Float4::load(z1.data());
+    auto s2 = Float4::load(z2.data());
+    auto energy = Float4::broadcast(0.0f);
+
+    for (int n = 0; n < numSamples; ++n) {
+        const auto x = Float4::broadcast(static_cast<float>(data[n]));
+        const auto y = cb0 * x + s1;
+        s1 = cb1 * x - ca1 * y + s2;
+        s2 = cb2 * x - ca2 * y;
+        energy = energy + y * y;
+    }
+
+    s1.store(z1.data());
+    s2.store(z2.data());
+
+    std::array<float, maxBands> result;
+    energy.store(result.data());
+    return result;
+}
+
+template std::array<float, BandEnergyAnalyser::maxBands> BandEnergyAnalyser::process(const float*, int) noexcept;
+template std::array<float, BandEnergyAnalyser::maxBands> BandEnergyAnalyser::process(const double*, int) noexcept;
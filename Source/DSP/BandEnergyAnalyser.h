@@ -0,0 +1,35 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+// ============================================================================
+// BandEnergyAnalyser
+// Responsibility: Runs up to four biquads side by side over the same input,
+// one per SIMD lane, and accumulates each band's energy (sum of squares) in
+// a single pass. Replaces three scalar juce::dsp::IIR::Filter instances and
+// their per-sample std::pow calls in SmartAutoEngine.
+// Filtering matches juce::dsp::IIR::Filter (transposed direct form II).
+// ============================================================================
+class BandEnergyAnalyser {
+public:
+    static constexpr int maxBands = 4;
+
+    BandEnergyAnalyser();
+
+    // Loads the normalised biquad coefficients [b0, b1, b2, a1, a2] for one
+    // band. Bands without coefficients stay silent.
+    void setBand(int band, const juce::dsp::IIR::Coefficients<float>& coeffs);
+    void reset();
+
+    // Filters `data` through every band; returns each band's sum of squares.
+    // Instantiated for float and double input; filtering is in float.
+    template <typename SampleType>
+    std::array<float, maxBands> process(const SampleType* data, int numSamples) noexcept;
+
+private:
+    // Structure of arrays: one lane per band
+    alignas(16) std::array<float, maxBands> b0 {}, b1 {}, b2 {}, a1 {}, a2 {};
+    alignas(16) std::array<float, maxBands> z1 {}, z2 {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BandEnergyAnalyser)
+};
@@ -0,0 +1,132 @@
+#include "EngineProfiler.h"
+
+namespace {
+
+    void accumulate(juce::int64& sum, juce::int64& worst, juce::int64 value) noexcept {
+        sum  += value;
+        worst = juce::jmax(worst, value);
+    }
+
+} // namespace
+
+const char* EngineProfiler::getStageName(Stage stage) noexcept {
+    switch (stage) {
+        case Stage::autoAnalysis: return "Auto analysis";
+        case Stage::gainRamps:    return "Gain ramps";
+        case Stage::oscillators:  return "Oscillators";
+        case Stage::mix:          return "Mix / duck";
+        case Stage::analysisFeed: return "Spectrum feed";
+        case Stage::sidechain:    return "Sidechain";
+        case Stage::toneMeters:   return "Tone meters";
+    }
+    return "";
+}
+
+juce::String EngineProfiler::describe(const Figures& f) {
+    auto row = [](const juce::String& name, const Timing& t) {
+        return name.paddedRight(' ', 16)
+             + juce::String(t.meanUs, 2).paddedLeft(' ', 10) + " us mean"
+             + juce::String(t.worstUs, 2).paddedLeft(' ', 10) + " us worst\n";
+    };
+
+    juce::String text;
+    for (int s = 0; s < numStages; ++s)
+        text << row(getStageName(static_cast<Stage>(s)), f.stages[static_cast<size_t>(s)]);
+    text << row("Total", f.callback);
+    text << "Load            " << juce::String(f.meanLoad * 100.0f, 2) << " % mean, "
+         << juce::String(f.worstLoad * 100.0f, 2) << " % worst over "
+         << juce::String(f.callbacks) << " callbacks\n";
+    return text;
+}
+
+void EngineProfiler::prepare(double newSampleRate) {
+    sampleRate.store(newSampleRate);
+    ticksPerSample = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / newSampleRate;
+
+    for (auto& v : publishedWindow)  v.store(0);
+    for (auto& v : publishedSession) v.store(0);
+
+   #if SOLFEGGIO_PROFILING
+    stageTicks.fill(0);
+    window.fill(0);
+    session.fill(0);
+    callbackStart = lastCallbackStart = lastBlockTicks = 0;
+    jitter = -1;
+    windowLength = static_cast<juce::int64>(newSampleRate * 0.5);
+   #endif
+}
+
+#if SOLFEGGIO_PROFILING
+void EngineProfiler::endCallback() noexcept {
+    const auto callbackTicks = juce::Time::getHighResolutionTicks() - callbackStart;
+    const auto loadPpm = static_cast<juce::int64>(1.0e6 * static_cast<double>(callbackTicks)
+                                                  / juce::jmax(1.0, blockSamples * ticksPerSample));
+
+    for (auto* totals : { &window, &session }) {
+        auto& t = *totals;
+        for (size_t s = 0; s < numStages; ++s)
+            accumulate(t[stageSum + s], t[stageWorst + s], stageTicks[s]);
+        accumulate(t[callbackSum], t[callbackWorst], callbackTicks);
+        t[worstLoadPpm] = juce::jmax(t[worstLoadPpm], loadPpm);
+        if (jitter >= 0) {
+            accumulate(t[jitterSum], t[jitterWorst], jitter);
+            ++t[jitterCount];
+        }
+        t[samples] += blockSamples;
+        ++t[callbacks];
+    }
+    stageTicks.fill(0);
+
+    store(publishedSession, session);
+    if (window[samples] >= windowLength) {
+        store(publishedWindow, window);
+        window.fill(0);
+    }
+}
+#endif
+
+void EngineProfiler::store(Published& dest, const Totals& source) noexcept {
+    for (size_t i = 0; i < numFields; ++i)
+        dest[i].store(source[i], std::memory_order_relaxed);
+}
+
+EngineProfiler::Figures EngineProfiler::toFigures(const Published& totals) const noexcept {
+    Totals t;
+    for (size_t i = 0; i < numFields; ++i)
+        t[i] = totals[i].load(std::memory_order_relaxed);
+
+    Figures f;
+    f.callbacks = t[callbacks];
+    if (f.callbacks == 0)
+        return f;
+
+    const double usPerTick = 1.0e6 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    const auto n = static_cast<double>(f.callbacks);
+    auto timing = [&](juce::int64 sum, juce::int64 worst) {
+        return Timing { static_cast<float>(static_cast<double>(sum) * usPerTick / n),
+                        static_cast<float>(static_cast<double>(worst) * usPerTick) };
+    };
+
+    for (size_t s = 0; s < numStages; ++s)
+        f.stages[s] = timing(t[stageSum + s], t[stageWorst + s]);
+    f.callback = timing(t[callbackSum], t[callbackWorst]);
+
+    const double audioUs = static_cast<double>(t[samples]) * 1.0e6 / juce::jmax(1.0, sampleRate.load());
+    f.meanLoad  = static_cast<float>(static_cast<double>(t[callbackSum]) * usPerTick / juce::jmax(1.0, audioUs));
+    f.worstLoad = static_cast<float>(static_cast<double>(t[worstLoadPpm]) * 1.0e-6);
+
+    if (t[jitterCount] > 0) {
+        f.meanJitterUs  = static_cast<float>(static_cast<double>(t[jitterSum]) * usPerTick / static_cast<double>(t[jitterCount]));
+        f.worstJitterUs = static_cast<float>(static_cast<double>(t[jitterWorst]) * usPerTick);
+    }
+    return f;
+}
+
+EngineProfiler::Snapshot EngineProfiler::getSnapshot() const noexcept {
+    Snapshot snapshot;
+    snapshot.enabled    = isEnabled();
+    snapshot.sampleRate = sampleRate.load();
+    snapshot.window     = toFigures(publishedWindow);
+    snapshot.session    = toFigures(publishedSession);
+    return snapshot;
+}
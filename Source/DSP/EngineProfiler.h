@@ -0,0 +1,156 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+// 1 = time every engine stage; 0 = every probe compiles to nothing.
+// Set from CMake (SOLFEGGIO_ENABLE_PROFILING); the render CLI always has it.
+#ifndef SOLFEGGIO_PROFILING
+ #define SOLFEGGIO_PROFILING 0
+#endif
+
+// ============================================================================
+// EngineProfiler
+// Responsibility: Per-stage timing of SolfeggioEngine::process plus callback
+// load and jitter, measured on the audio thread and published through
+// atomics for the editor's diagnostics panel and the offline tools.
+//
+// The audio thread sums into plain members and stores the totals into
+// atomics: the running session totals after every callback, and a windowed
+// copy (about half a second of audio) each time a window completes. Readers
+// may catch a copy mid-way, which only mixes two adjacent callbacks' or
+// windows' figures. Jitter is the difference between the time between two
+// callbacks and the previous block's duration, so it is only meaningful
+// when the host runs in real time.
+//
+// With SOLFEGGIO_PROFILING=0 the audio-thread calls are empty inline
+// functions and getSnapshot() reports enabled = false.
+// ============================================================================
+class EngineProfiler {
+public:
+    enum class Stage { autoAnalysis, gainRamps, oscillators, mix, analysisFeed, sidechain, toneMeters };
+    static constexpr int numStages = 7;
+
+    struct Timing {
+        float meanUs  = 0.0f;
+        float worstUs = 0.0f;
+    };
+
+    struct Figures {
+        std::array<Timing, numStages> stages {};
+        Timing callback;              // the whole process() call
+        float meanLoad      = 0.0f;   // callback time / block duration
+        float worstLoad     = 0.0f;
+        float meanJitterUs  = 0.0f;
+        float worstJitterUs = 0.0f;
+        juce::int64 callbacks = 0;
+    };
+
+    struct Snapshot {
+        bool enabled = false;
+        double sampleRate = 0.0;
+        Figures window;    // the last completed window
+        Figures session;   // everything since prepare()
+    };
+
+    EngineProfiler() = default;
+
+    static constexpr bool isEnabled() noexcept { return SOLFEGGIO_PROFILING != 0; }
+    static const char* getStageName(Stage stage) noexcept;
+
+    // Per-stage table for console output, e.g. the render CLI's --profile
+    static juce::String describe(const Figures& figures);
+
+    // Resets the session; not concurrent with the audio thread
+    void prepare(double sampleRate);
+
+    // Any thread
+    Snapshot getSnapshot() const noexcept;
+
+   #if SOLFEGGIO_PROFILING
+    // Audio thread — brackets one process() call
+    void beginCallback(int numSamples) noexcept {
+        const auto now = juce::Time::getHighResolutionTicks();
+        if (lastCallbackStart != 0)
+            jitter = std::abs((now - lastCallbackStart) - lastBlockTicks);
+        else
+            jitter = -1;
+        lastCallbackStart = now;
+        callbackStart = now;
+        blockSamples = numSamples;
+        lastBlockTicks = static_cast<juce::int64>(numSamples * ticksPerSample);
+    }
+
+    void endCallback() noexcept;
+
+    // Audio thread — charges the lifetime of the scope to a stage;
+    // switchTo() closes the current stage and opens the next one
+    class ScopedStage {
+    public:
+        ScopedStage(EngineProfiler& p, Stage s) noexcept
+            : profiler(p), stage(static_cast<size_t>(s)), start(juce::Time::getHighResolutionTicks()) {}
+        ~ScopedStage() noexcept { profiler.stageTicks[stage] += juce::Time::getHighResolutionTicks() - start; }
+
+        void switchTo(Stage next) noexcept {
+            const auto now = juce::Time::getHighResolutionTicks();
+            profiler.stageTicks[stage] += now - start;
+            stage = static_cast<size_t>(next);
+            start = now;
+        }
+
+        ScopedStage(const ScopedStage&) = delete;
+        ScopedStage& operator=(const ScopedStage&) = delete;
+
+    private:
+        EngineProfiler& profiler;
+        size_t stage;
+        juce::int64 start;
+    };
+   #else
+    void beginCallback(int) noexcept {}
+    void endCallback() noexcept {}
+
+    class ScopedStage {
+    public:
+        ScopedStage(EngineProfiler&, Stage) noexcept {}
+        void switchTo(Stage) noexcept {}
+    };
+   #endif
+
+private:
+    // Raw totals in high-resolution ticks, one slot per field
+    enum Field {
+        stageSum,
+        stageWorst    = stageSum + numStages,
+        callbackSum   = stageWorst + numStages,
+        callbackWorst,
+        worstLoadPpm,
+        jitterSum,
+        jitterWorst,
+        jitterCount,
+        samples,
+        callbacks,
+        numFields
+    };
+    using Totals    = std::array<juce::int64, numFields>;
+    using Published = std::array<std::atomic<juce::int64>, numFields>;
+
+    static void store(Published& dest, const Totals& source) noexcept;
+    Figures toFigures(const Published& totals) const noexcept;
+
+    Published publishedWindow {};
+    Published publishedSession {};
+    std::atomic<double> sampleRate { 0.0 };
+    double ticksPerSample = 0.0;
+
+   #if SOLFEGGIO_PROFILING
+    // Audio thread only
+    std::array<juce::int64, numStages> stageTicks {};
+    Totals window {}, session {};
+    juce::int64 callbackStart = 0, lastCallbackStart = 0, lastBlockTicks = 0, jitter = -1;
+    juce::int64 windowLength = 0;
+    int blockSamples = 0;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineProfiler)
+};
@@ -0,0 +1,112 @@
+#include "GoertzelBank.h"
+#include "SimdLanes.h"
+
+static_assert(2 * Simd::Float8::width == 16, "two vectors cover the lanes");
+
+GoertzelBank::GoertzelBank() {}
+
+void GoertzelBank::prepare(double sampleRate) {
+    frameLength = juce::jmax(64, static_cast<int>(std::lround(frameSeconds * sampleRate)));
+
+    window = dspCache->getWindow(juce::dsp::WindowingFunction<float>::hann, frameLength, false);
+    double windowSum = 0.0;
+    for (float w : *window)
+        windowSum += w;
+    levelScale = static_cast<float>(2.0 / windowSum);
+
+    coeff.fill(0.0f);
+    for (size_t i = 0; i < numTones; ++i)
+        coeff[i] = static_cast<float>(2.0 * std::cos(juce::MathConstants<double>::twoPi
+                                                     * Solfeggio::Frequencies[i] / sampleRate));
+    reset();
+}
+
+void GoertzelBank::reset() {
+    for (int p = 0; p < numPhases; ++p) {
+        std::fill(std::begin(s1[p]), std::end(s1[p]), 0.0f);
+        std::fill(std::begin(s2[p]), std::end(s2[p]), 0.0f);
+    }
+
+    // The second phase starts half-way through its frame, so its first
+    // frame is incomplete and is not published
+    framePos  = { 0, frameLength / 2 };
+    frameValid = { true, false };
+
+    levels.fill(0.0f);
+    for (auto& l : publishedLevels)
+        l.store(0.0f, std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+void GoertzelBank::process(const SampleType* data, int numSamples) noexcept {
+    // Run both phases up to whichever frame ends first, then close it
+    while (numSamples > 0) {
+        const int span = juce::jmin(numSamples, frameLength - framePos[0], frameLength - framePos[1]);
+
+        runFrames(data, span);
+        for (int p = 0; p < numPhases; ++p) {
+            auto& pos = framePos[static_cast<size_t>(p)];
+            pos += span;
+            if (pos == frameLength) {
+                finishFrame(p);
+                pos = 0;
+            }
+        }
+
+        data += span;
+        numSamples -= span;
+    }
+}
+
+template <typename SampleType>
+void GoertzelBank::runFrames(const SampleType* data, int numSamples) noexcept {
+    using Simd::Float8;
+    constexpr int w = Float8::width;
+    const float* winA = window->data() + framePos[0];
+    const float* winB = window->data() + framePos[1];
+
+    const auto cLo = Float8::load(coeff.data()), cHi = Float8::load(coeff.data() + w);
+    auto a1Lo = Float8::load(s1[0]), a1Hi = Float8::load(s1[0] + w);
+    auto a2Lo = Float8::load(s2[0]), a2Hi = Float8::load(s2[0] + w);
+    auto b1Lo = Float8::load(s1[1]), b1Hi = Float8::load(s1[1] + w);
+    auto b2Lo = Float8::load(s2[1]), b2Hi = Float8::load(s2[1] + w);
+
+    // s0 = x + 2cos(w) s1 - s2 for every tone off the same windowed sample.
+    // Both phases share the loop: four independent recurrences hide each
+    // other's latency.
+    for (int n = 0; n < numSamples; ++n) {
+        const auto x  = static_cast<float>(data[n]);
+        const auto xa = Float8::broadcast(x * winA[n]);
+        const auto xb = Float8::broadcast(x * winB[n]);
+        const auto aLo = xa + cLo * a1Lo - a2Lo, aHi = xa + cHi * a1Hi - a2Hi;
+        const auto bLo = xb + cLo * b1Lo - b2Lo, bHi = xb + cHi * b1Hi - b2Hi;
+        a2Lo = a1Lo; a1Lo = aLo; a2Hi = a1Hi; a1Hi = aHi;
+        b2Lo = b1Lo; b1Lo = bLo; b2Hi = b1Hi; b1Hi = bHi;
+    }
+
+    a1Lo.store(s1[0]); a1Hi.store(s1[0] + w);
+    a2Lo.store(s2[0]); a2Hi.store(s2[0] + w);
+    b1Lo.store(s1[1]); b1Hi.store(s1[1] + w);
+    b2Lo.store(s2[1]); b2Hi.store(s2[1] + w);
+}
+
+void GoertzelBank::finishFrame(int phase) noexcept {
+    const auto p = static_cast<size_t>(phase);
+
+    if (frameValid[p]) {
+        for (size_t i = 0; i < numTones; ++i) {
+            // |X|^2 from the last two states; double, since the terms nearly cancel
+            const double a = s1[phase][i], b = s2[phase][i];
+            const double power = a * a + b * b - static_cast<double>(coeff[i]) * a * b;
+            levels[i] = levelScale * static_cast<float>(std::sqrt(juce::jmax(0.0, power)));
+            publishedLevels[i].store(levels[i], std::memory_order_relaxed);
+        }
+    }
+
+    frameValid[p] = true;
+    std::fill(std::begin(s1[phase]), std::end(s1[phase]), 0.0f);
+    std::fill(std::begin(s2[phase]), std::end(s2[phase]), 0.0f);
+}
+
+template void GoertzelBank::process(const float*, int) noexcept;
+template void GoertzelBank::process(const double*, int) noexcept;
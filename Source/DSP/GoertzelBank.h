@@ -0,0 +1,72 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include "Constants.h"
+#include "SharedDspCache.h"
+
+// ============================================================================
+// GoertzelBank
+// Responsibility: Level of the signal at each of the ten Solfeggio
+// frequencies, for the per-tone meters. One Goertzel
+// recurrence per tone, all ten run side by side in SIMD lanes off the same
+// input sample, so the cost per sample is a few vector multiply-adds
+// whatever the sample rate.
+//
+// Each detector integrates a Hann-windowed frame of `frameSeconds`; two
+// frame phases run half a frame apart, so a new set of levels lands every
+// half frame. 200 ms frames give 5 Hz bins, which puts the closest pair
+// (417 / 432 Hz) three bins apart, outside each other's Hann main lobe; the
+// benchmark suite checks the leakage between them. Levels are the peak
+// amplitude of a sine at that frequency, so a full-scale tone reads 1.0.
+// ============================================================================
+class GoertzelBank {
+public:
+    static constexpr int numTones = Solfeggio::NUM_FREQUENCIES;
+    static constexpr double frameSeconds = 0.2;
+
+    GoertzelBank();
+
+    // Picks up the window table for this rate; not real-time safe
+    void prepare(double sampleRate);
+    void reset();
+
+    // Audio thread; float or double input
+    template <typename SampleType>
+    void process(const SampleType* data, int numSamples) noexcept;
+    const std::array<float, numTones>& getLevels() const noexcept { return levels; }
+
+    // Any thread — the latest levels published by process()
+    float getLevel(int tone) const noexcept {
+        return publishedLevels[static_cast<size_t>(tone)].load(std::memory_order_relaxed);
+    }
+
+private:
+    // Ten tones padded to two 8-lane vectors
+    static constexpr int numLanes = 16;
+    static constexpr int numPhases = 2;
+    static_assert(numPhases == 2, "runFrames() unrolls both phases");
+
+    template <typename SampleType>
+    void runFrames(const SampleType* data, int numSamples) noexcept;
+    void finishFrame(int phase) noexcept;
+
+    int frameLength = 8820;
+    float levelScale = 0.0f;        // 2 / sum(window)
+    std::shared_ptr<const SharedDspCache::Table> window;
+    juce::SharedResourcePointer<SharedDspCache> dspCache;
+
+    alignas(32) std::array<float, numLanes> coeff {};   // 2 cos(w) per tone
+    alignas(32) float s1[numPhases][numLanes] {};
+    alignas(32) float s2[numPhases][numLanes] {};
+    std::array<int, numPhases> framePos {};
+    std::array<bool, numPhases> frameValid {};         // false until a whole frame was seen
+
+    std::array<float, numTones> levels {};
+    std::array<std::atomic<float>, numTones> publishedLevels {};
+
+    static_assert(numTones <= numLanes, "one lane per tone");
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GoertzelBank)
+};
@@ -0,0 +1,93 @@
+#include "OscillatorBank.h"
+#include "SimdLanes.h"
+
+static_assert(OscillatorBank::laneWidth == Simd::Float8::width, "one lane frame per SIMD vector");
+
+OscillatorBank::OscillatorBank() {}
+
+void OscillatorBank::prepare(double sampleRate) {
+    constexpr double twoPi = juce::MathConstants<double>::twoPi;
+
+    for (int v = 0; v < numVoices; ++v) {
+        auto idx = static_cast<size_t>(v);
+        const double inc = static_cast<double>(Solfeggio::Frequencies[idx]) * twoPi / sampleRate;
+        phaseIncrement[idx] = inc;
+
+        for (int k = 0; k < laneWidth; ++k) {
+            laneCos[v][k] = std::cos(inc * k);
+            laneSin[v][k] = std::sin(inc * k);
+        }
+        frameCos[idx] = static_cast<float>(std::cos(inc * laneWidth));
+        frameSin[idx] = static_cast<float>(std::sin(inc * laneWidth));
+    }
+    reset();
+}
+
+void OscillatorBank::reset() {
+    phase.fill(0.0);
+}
+
+void OscillatorBank::advancePhase(size_t voice, int numSamples) noexcept {
+    constexpr double twoPi = juce::MathConstants<double>::twoPi;
+
+    double p = phase[voice] + phaseIncrement[voice] * numSamples;
+    if (p >= twoPi)
+        p -= twoPi * std::floor(p / twoPi);
+    phase[voice] = p;
+}
+
+void OscillatorBank::render(float* output, const float* const* gains, int numSamples) noexcept {
+    // Active-voice list for this call; silent voices never enter the loop
+    std::array<int, numVoices> active;
+    int numActive = 0;
+    for (int v = 0; v < numVoices; ++v) {
+        if (gains[v] != nullptr)
+            active[static_cast<size_t>(numActive++)] = v;
+        else
+            advancePhase(static_cast<size_t>(v), numSamples);
+    }
+
+    for (int start = 0; start < numSamples; start += resyncInterval) {
+        const int chunk = juce::jmin(resyncInterval, numSamples - start);
+        float* out = output + start;
+
+        for (int a = 0; a < numActive; ++a) {
+            const int v = active[static_cast<size_t>(a)];
+            const float* gain = gains[v] + start;
+
+            // Seed the lanes from the exact double phase — this is the
+            // renormalisation step that keeps the recurrence drift-free.
+            auto idx = static_cast<size_t>(v);
+            const double s0 = std::sin(phase[idx]);
+            const double c0 = std::cos(phase[idx]);
+
+            alignas(32) float seedSin[laneWidth], seedCos[laneWidth];
+            for (int k = 0; k < laneWidth; ++k) {
+                seedSin[k] = static_cast<float>(s0 * laneCos[v][k] + c0 * laneSin[v][k]);
+                seedCos[k] = static_cast<float>(c0 * laneCos[v][k] - s0 * laneSin[v][k]);
+            }
+
+            auto s = Simd::Float8::load(seedSin);
+            auto c = Simd::Float8::load(seedCos);
+            const auto rc = Simd::Float8::broadcast(frameCos[idx]);
+            const auto rs = Simd::Float8::broadcast(frameSin[idx]);
+
+            int n = 0;
+            for (; n + laneWidth <= chunk; n += laneWidth) {
+                (Simd::Float8::load(out + n) + Simd::Float8::load(gain + n) * s).store(out + n);
+
+                const auto ns = s * rc + c * rs;
+                c = c * rc - s * rs;
+                s = ns;
+            }
+
+            if (n < chunk) {
+                s.store(seedSin);
+                for (int k = 0; n + k < chunk; ++k)
+                    out[n + k] += gain[n + k] * seedSin[k];
+            }
+
+            advancePhase(idx, chunk);
+        }
+    }
+}
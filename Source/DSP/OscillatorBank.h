@@ -0,0 +1,55 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "Constants.h"
+
+// ============================================================================
+// OscillatorBank
+// Responsibility: Renders all Solfeggio sine voices from one structure-of-
+// arrays state block, without calling std::sin per sample.
+//
+// Each voice is a complex rotator spread across `laneWidth` consecutive
+// samples: one update advances eight samples of a voice, which maps to a
+// single AVX2 register (two SSE/NEON registers). Phase is kept in double
+// precision and the rotators are re-seeded from it every `resyncInterval`
+// samples, which renormalises the amplitude and stops drift.
+//
+// Accuracy: the OscillatorBank benchmark suite checks the max error against
+// an exact double-precision sine over a minute of output at several block
+// sizes. The old float-phase SineOscillator accumulated rounding in its
+// phase and drifted away from that reference.
+// ============================================================================
+class OscillatorBank {
+public:
+    static constexpr int numVoices      = Solfeggio::NUM_FREQUENCIES;
+    static constexpr int laneWidth      = 8;
+    static constexpr int resyncInterval = 256;
+
+    OscillatorBank();
+
+    void prepare(double sampleRate);
+    void reset();
+
+    // Adds sum(gains[v][n] * sin(phase_v[n])) into output[0..numSamples).
+    // A nullptr entry in `gains` marks a silent voice: it is left out of the
+    // render loop entirely and its phase is advanced analytically, once per
+    // call, so it comes back in phase.
+    void render(float* output, const float* const* gains, int numSamples) noexcept;
+
+private:
+    void advancePhase(size_t voice, int numSamples) noexcept;
+
+    std::array<double, numVoices> phase          {};
+    std::array<double, numVoices> phaseIncrement {};
+
+    // Per-voice rotation by one lane frame (laneWidth samples)
+    std::array<float, numVoices> frameCos {}, frameSin {};
+
+    // Per-voice lane offsets: cos/sin of (k * phaseIncrement), k < laneWidth
+    alignas(32) double laneCos[numVoices][laneWidth] {};
+    alignas(32) double laneSin[numVoices][laneWidth] {};
+
+    static_assert(resyncInterval % laneWidth == 0, "resync must land on a lane frame");
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscillatorBank)
+};
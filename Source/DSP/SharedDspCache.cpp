@@ -0,0 +1,41 @@
+#include "SharedDspCache.h"
+
+template <typename T, typename Key, typename Make>
+std::shared_ptr<const T> SharedDspCache::findOrMake(std::map<Key, std::weak_ptr<const T>>& entries,
+                                                    const Key& key, Make&& make) {
+    if (auto existing = entries[key].lock())
+        return existing;
+
+    std::shared_ptr<const T> made = make();
+    entries[key] = made;
+    return made;
+}
+
+std::shared_ptr<const juce::dsp::FFT> SharedDspCache::getFft(int order) {
+    const std::lock_guard<std::mutex> guard(lock);
+    return findOrMake(ffts, order, [order] { return std::make_shared<const juce::dsp::FFT>(order); });
+}
+
+std::shared_ptr<const SharedDspCache::Table> SharedDspCache::getWindow(WindowMethod method, int size, bool normalise) {
+    const std::lock_guard<std::mutex> guard(lock);
+    return findOrMake(windows, std::make_tuple(static_cast<int>(method), size, normalise), [=] {
+        auto table = std::make_shared<Table>(static_cast<size_t>(size));
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(table->data(), static_cast<size_t>(size),
+                                                                 method, normalise);
+        return std::shared_ptr<const Table>(std::move(table));
+    });
+}
+
+std::shared_ptr<const SharedDspCache::Coefficients> SharedDspCache::getBiquad(Filter type, double sampleRate,
+                                                                             float frequency, float q) {
+    const std::lock_guard<std::mutex> guard(lock);
+    return findOrMake(biquads, std::make_tuple(static_cast<int>(type), sampleRate, frequency, q), [=] {
+        Coefficients::Ptr made;
+        switch (type) {
+            case Filter::lowPass:  made = Coefficients::makeLowPass (sampleRate, frequency);    break;
+            case Filter::bandPass: made = Coefficients::makeBandPass(sampleRate, frequency, q); break;
+            case Filter::highPass: made = Coefficients::makeHighPass(sampleRate, frequency);    break;
+        }
+        return std::make_shared<const Coefficients>(*made);
+    });
+}
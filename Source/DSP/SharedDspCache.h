@@ -0,0 +1,52 @@
+#pragma once
+#include <JuceHeader.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+// ============================================================================
+// SharedDspCache
+// Responsibility: One process-wide store of the read-only tables every
+// engine instance would otherwise build for itself — FFT plans, window
+// tables and biquad coefficient sets — keyed by size / sample rate. Held
+// through juce::SharedResourcePointer, so it lives as long as any instance.
+//
+// Every entry is handed out as shared_ptr<const T> and the cache keeps only
+// weak references: an entry is built on first request, shared while anyone
+// holds it, and freed when the last holder lets go (e.g. after every
+// instance moved to another sample rate).
+//
+// Lookups lock a mutex and may build the entry: call them from prepare()
+// or the analysis thread, never from the audio thread. The entries are
+// immutable. juce::dsp::FFT::perform() is const but some platform back-ends
+// use a scratch buffer in the plan, so a shared plan must only be run from
+// one thread at a time — SpectrumAnalysis runs all of its FFTs on its one
+// shared analysis thread.
+// ============================================================================
+class SharedDspCache {
+public:
+    using Table          = std::vector<float>;
+    using WindowMethod   = juce::dsp::WindowingFunction<float>::WindowingMethod;
+    using Coefficients   = juce::dsp::IIR::Coefficients<float>;
+    enum class Filter { lowPass, bandPass, highPass };
+
+    std::shared_ptr<const juce::dsp::FFT> getFft(int order);
+
+    // JUCE's windowing tables; `normalise` scales the sum to `size`
+    std::shared_ptr<const Table> getWindow(WindowMethod method, int size, bool normalise);
+
+    // RBJ biquad at (sampleRate, frequency, q); q is ignored for low/high-pass
+    std::shared_ptr<const Coefficients> getBiquad(Filter type, double sampleRate, float frequency, float q = 0.7071f);
+
+private:
+    template <typename T, typename Key, typename Make>
+    static std::shared_ptr<const T> findOrMake(std::map<Key, std::weak_ptr<const T>>& entries,
+                                               const Key& key, Make&& make);
+
+    std::mutex lock;
+    std::map<int, std::weak_ptr<const juce::dsp::FFT>> ffts;
+    std::map<std::tuple<int, int, bool>, std::weak_ptr<const Table>> windows;
+    std::map<std::tuple<int, double, float, float>, std::weak_ptr<const Coefficients>> biquads;
+};
@@ -1,61 +1,326 @@
 #include "SidechainCompressor.h"
+#include "SimdLanes.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
 
-SidechainCompressor::SidechainCompressor() {
-    rmsBuffer.resize(256, 0.0f);
+namespace {
+    constexpr int channelLanes = Simd::Float4::width;
+
+    int paddedChannels(int numChannels) {
+        return (numChannels + channelLanes - 1) / channelLanes * channelLanes;
+    }
 }
 
-void SidechainCompressor::prepare(double sampleRate, int /*samplesPerBlock*/) {
+void SidechainCompressor::prepare(double sampleRate, int samplesPerBlock, int numChannels) {
     currentSampleRate = sampleRate;
-    envelopeLevel = 0.0f;
-    rmsWritePos = 0;
-    rmsSum = 0.0f;
-    std::fill(rmsBuffer.begin(), rmsBuffer.end(), 0.0f);
+    maxBlockSize = juce::jmax(1, samplesPerBlock);
+
+    keyFilter = dspCache->getBiquad(SharedDspCache::Filter::bandPass, sampleRate, 800.0f, 1.5f);
+    std::copy(keyFilter->getRawCoefficients(), keyFilter->getRawCoefficients() + 5, keyCoeffs.begin());
+
+    numPreparedChannels = juce::jmax(1, numChannels);
+    const auto lanes = static_cast<size_t>(paddedChannels(numPreparedChannels));
+    keyZ1.assign(lanes, 0.0f);
+    keyZ2.assign(lanes, 0.0f);
+    keyLevels.assign(lanes * static_cast<size_t>(maxBlockSize), 0.0f);
+    envelopes.assign(static_cast<size_t>(numPreparedChannels), 0.0f);
 
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, 800.0f, 1.5f);
-    sidechainFilter.coefficients = coeffs;
-    sidechainFilter.reset();
+    lookahead = lookaheadSamples(lookaheadMs.load(), sampleRate);
+    delayLength = juce::nextPowerOfTwo(lookaheadSamples(maxLookaheadMs, sampleRate) + 1);
+    const auto ringSize = static_cast<size_t>(numPreparedChannels) * static_cast<size_t>(delayLength);
+    delayLines.assign(ringSize, 0.0);
+    peakFrames.assign(ringSize, 0);
+    peakLevels.assign(ringSize, 0.0f);
+    peakHeads.assign(static_cast<size_t>(numPreparedChannels), 0);
+    peakTails.assign(static_cast<size_t>(numPreparedChannels), 0);
+    clearLookahead();
 
-    float atk = attackMs.load();
-    float rel = releaseMs.load();
-    attackCoeff  = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * atk  * 0.001f));
-    releaseCoeff = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * rel * 0.001f));
+    rmsLength = juce::jmax(1, juce::roundToInt(rmsWindowMs * 0.001 * sampleRate));
+    rmsSquares.assign(static_cast<size_t>(rmsLength) * static_cast<size_t>(numPreparedChannels), 0.0);
+    rmsSums.assign(static_cast<size_t>(numPreparedChannels), 0.0);
+    resetRms();
+
+    settingsValid = false;
+    updateSettings(loadSettings());
 }
 
 void SidechainCompressor::reset() {
-    envelopeLevel = 0.0f;
+    resetRms();
+    std::fill(keyZ1.begin(), keyZ1.end(), 0.0f);
+    std::fill(keyZ2.begin(), keyZ2.end(), 0.0f);
+    std::fill(envelopes.begin(), envelopes.end(), 0.0f);
+    clearLookahead();
+}
+
+int SidechainCompressor::lookaheadSamples(float ms, double sampleRate) noexcept {
+    return juce::roundToInt(juce::jlimit(0.0f, maxLookaheadMs, ms) * 0.001 * sampleRate);
+}
+
+// Starts the delay and the peak windows from silence
+void SidechainCompressor::clearLookahead() {
+    frameCounter = 0;
+    std::fill(delayLines.begin(), delayLines.end(), 0.0);
+    std::fill(peakHeads.begin(), peakHeads.end(), 0u);
+    std::fill(peakTails.begin(), peakTails.end(), 0u);
+}
+
+float SidechainCompressor::windowPeak(int detector, float level) noexcept {
+    const auto mask = static_cast<std::uint32_t>(delayLength - 1);
+    const auto base = static_cast<size_t>(detector) * static_cast<size_t>(delayLength);
+    std::uint32_t* frames = peakFrames.data() + base;
+    float* levels = peakLevels.data() + base;
+    auto& head = peakHeads[static_cast<size_t>(detector)];
+    auto& tail = peakTails[static_cast<size_t>(detector)];
+
+    // The window is this frame and the `lookahead` before it; at most the
+    // front entry can have just left it. Dropping it first keeps the deque
+    // at lookahead + 1 entries, within the ring.
+    if (head != tail && frameCounter - frames[head & mask] > static_cast<std::uint32_t>(lookahead))
+        ++head;
+
+    // Entries no louder than the new level can never be the peak again
+    while (head != tail && levels[(tail - 1) & mask] <= level)
+        --tail;
+
+    frames[tail & mask] = frameCounter;
+    levels[tail & mask] = level;
+    ++tail;
+    return levels[head & mask];
+}
+
+template <typename SampleType>
+SampleType SidechainCompressor::delayed(int channel, SampleType input) noexcept {
+    const auto mask = static_cast<std::uint32_t>(delayLength - 1);
+    double* line = delayLines.data() + static_cast<size_t>(channel) * static_cast<size_t>(delayLength);
+    line[frameCounter & mask] = static_cast<double>(input);
+    return static_cast<SampleType>(line[(frameCounter - static_cast<std::uint32_t>(lookahead)) & mask]);
+}
+
+// Starts the RMS windows from silence
+void SidechainCompressor::resetRms() {
     rmsWritePos = 0;
-    rmsSum = 0.0f;
-    std::fill(rmsBuffer.begin(), rmsBuffer.end(), 0.0f);
-    sidechainFilter.reset();
+    std::fill(rmsSquares.begin(), rmsSquares.end(), 0.0);
+    std::fill(rmsSums.begin(), rmsSums.end(), 0.0);
+}
+
+// Peak windows and RMS sums hold levels of the old kind after a detector
+// or link change, so they start over. The audio in the delay line is kept,
+// and so is the gain: unlinking starts every channel from the linked
+// envelope, linking starts from the loudest channel's.
+void SidechainCompressor::restartDetection(LinkMode link, bool rms) noexcept {
+    resetRms();
+    std::fill(peakHeads.begin(), peakHeads.end(), 0u);
+    std::fill(peakTails.begin(), peakTails.end(), 0u);
+
+    if (link == LinkMode::Unlinked && activeLink != LinkMode::Unlinked)
+        std::fill(envelopes.begin() + 1, envelopes.end(), envelopes[0]);
+    else if (link != LinkMode::Unlinked && activeLink == LinkMode::Unlinked)
+        envelopes[0] = *std::max_element(envelopes.begin(), envelopes.end());
+
+    activeLink = link;
+    rmsActive = rms;
+}
+
+// Replaces the block's |key| levels in keyLevels with each channel's RMS
+// over the window ending at that sample
+void SidechainCompressor::rmsLevels(int numChannels, int numSamples) noexcept {
+    const auto stride = static_cast<size_t>(paddedChannels(numPreparedChannels));
+    const auto channels = static_cast<size_t>(numPreparedChannels);
+    const double invLength = 1.0 / static_cast<double>(rmsLength);
+    double* sums = rmsSums.data();
+
+    float* levels = keyLevels.data();
+    for (int i = 0; i < numSamples; ++i, levels += stride) {
+        double* squares = rmsSquares.data() + static_cast<size_t>(rmsWritePos) * channels;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const auto level = static_cast<double>(levels[ch]);
+            const double square = level * level;
+            sums[ch] += square - squares[ch];
+            squares[ch] = square;
+            // The sum can round a hair below zero once the window is silent
+            levels[ch] = static_cast<float>(std::sqrt(juce::jmax(0.0, sums[ch]) * invLength));
+        }
+        if (++rmsWritePos == rmsLength)
+            rmsWritePos = 0;
+    }
+}
+
+SidechainCompressor::Settings SidechainCompressor::loadSettings() const {
+    return { attackMs.load(), releaseMs.load(), thresholdDb.load(), ratio.load(), kneeWidthDb.load() };
+}
+
+void SidechainCompressor::updateSettings(const Settings& s) {
+    const bool timingChanged = ! settingsValid
+                            || ! juce::exactlyEqual(s.attackMs, active.attackMs)
+                            || ! juce::exactlyEqual(s.releaseMs, active.releaseMs);
+    const bool curveChanged  = ! settingsValid
+                            || ! juce::exactlyEqual(s.thresholdDb, active.thresholdDb)
+                            || ! juce::exactlyEqual(s.ratio, active.ratio)
+                            || ! juce::exactlyEqual(s.kneeWidthDb, active.kneeWidthDb);
+    active = s;
+    settingsValid = true;
+
+    if (timingChanged) {
+        const auto sr = static_cast<float>(currentSampleRate);
+        attackCoeff  = 1.0f - std::exp(-1.0f / (sr * s.attackMs  * 0.001f));
+        releaseCoeff = 1.0f - std::exp(-1.0f / (sr * s.releaseMs * 0.001f));
+    }
+
+    if (curveChanged) {
+        const float halfKnee = s.kneeWidthDb * 0.5f;
+        kneeStartDb = s.thresholdDb - halfKnee;
+        kneeEndDb   = s.thresholdDb + halfKnee;
+        slope       = 1.0f - 1.0f / s.ratio;
+        kneeScale   = s.kneeWidthDb > 0.0f ? slope / (4.0f * s.kneeWidthDb) : 0.0f;
+        buildGainTable();
+    }
+}
+
+void SidechainCompressor::buildGainTable() {
+    // Entry k sits at mantissa step (k mod 2^bits) of octave (k >> bits), so
+    // a lookup can interpolate linearly on the raw mantissa bits.
+    constexpr int stepsPerOctave = 1 << gainTableOctaveBits;
+    for (int k = 0; k < gainTableSize; ++k) {
+        const float mantissa = 1.0f + static_cast<float>(k % stepsPerOctave) / stepsPerOctave;
+        const int exponent = gainTableMinExponent + k / stepsPerOctave;
+        gainTable[static_cast<size_t>(k)] = exactGain(std::ldexp(mantissa, exponent));
+    }
 }
 
 float SidechainCompressor::computeGainReduction(float levelDb) const {
-    float thresh = thresholdDb.load();
-    float r = ratio.load();
-    float knee = kneeWidthDb.load();
-    float halfKnee = knee * 0.5f;
-    float diff = levelDb - thresh;
-    if (diff <= -halfKnee) return 0.0f;
-    if (diff >= halfKnee) return diff * (1.0f - 1.0f / r);
-    float x = diff + halfKnee;
-    return (x * x) / (4.0f * knee) * (1.0f - 1.0f / r);
-}
-
-void SidechainCompressor::process(float* data, const float* sidechainInput, int numSamples) {
-    float atk = attackMs.load();
-    float rel = releaseMs.load();
-    float wet = dryWet.load();
-    attackCoeff  = 1.0f - std::exp(-1.0f / (static_cast<float>(currentSampleRate) * atk  * 0.001f));
-    releaseCoeff = 1.0f - std::exp(-1.0f / (static_cast<float>(currentSampleRate) * rel * 0.001f));
-
-    for (int i = 0; i < numSamples; ++i) {
-        float filtered = sidechainFilter.processSample(sidechainInput[i]);
-        float level = std::abs(filtered);
-        float coeff = (level > envelopeLevel) ? attackCoeff : releaseCoeff;
-        envelopeLevel += coeff * (level - envelopeLevel);
-        float levelDb = juce::Decibels::gainToDecibels(envelopeLevel, -100.0f);
-        float reductionDb = computeGainReduction(levelDb);
-        float gainLin = juce::Decibels::decibelsToGain(-reductionDb);
-        data[i] = data[i] * (1.0f - wet) + (data[i] * gainLin) * wet;
+    if (levelDb <= kneeStartDb) return 0.0f;
+    if (levelDb >= kneeEndDb) return (levelDb - active.thresholdDb) * slope;
+    float x = levelDb - kneeStartDb;
+    return x * x * kneeScale;
+}
+
+float SidechainCompressor::exactGain(float envelope) const {
+    const float levelDb = juce::Decibels::gainToDecibels(envelope, -100.0f);
+    return juce::Decibels::decibelsToGain(-computeGainReduction(levelDb));
+}
+
+float SidechainCompressor::lookupGain(float envelope) const noexcept {
+    constexpr int fractionBits = 23 - gainTableOctaveBits;
+    constexpr auto firstSegment = static_cast<std::uint32_t>(127 + gainTableMinExponent) << gainTableOctaveBits;
+
+    // The envelope is never negative, so its bit pattern orders like the value
+    const auto bits = std::bit_cast<std::uint32_t>(envelope);
+    const auto segment = bits >> fractionBits;
+    if (segment < firstSegment)
+        return gainTable.front();   // below -100 dB: the floor applies
+
+    const auto index = static_cast<size_t>(segment - firstSegment);
+    if (index >= static_cast<size_t>(gainTableSize - 1))
+        return exactGain(envelope);
+
+    const float frac = static_cast<float>(bits & ((1u << fractionBits) - 1u)) * (1.0f / (1u << fractionBits));
+    return gainTable[index] + frac * (gainTable[index + 1] - gainTable[index]);
+}
+
+float SidechainCompressor::envelopeToGain(float& envelope, float level) const noexcept {
+    float coeff = (level > envelope) ? attackCoeff : releaseCoeff;
+    envelope += coeff * (level - envelope);
+    return lookupGain(envelope);
+}
+
+template <typename SampleType>
+void SidechainCompressor::filterKeys(const SampleType* const* channels, int startSample,
+                                     int numChannels, int numSamples) noexcept {
+    using Simd::Float4;
+    const auto b0 = Float4::broadcast(keyCoeffs[0]), b1 = Float4::broadcast(keyCoeffs[1]);
+    const auto b2 = Float4::broadcast(keyCoeffs[2]), a1 = Float4::broadcast(keyCoeffs[3]);
+    const auto a2 = Float4::broadcast(keyCoeffs[4]);
+    const int  stride = paddedChannels(numPreparedChannels);
+
+    // One group of up to four channels at a time, one SIMD lane per channel;
+    // the filter state stays in registers for the whole block.
+    for (int group = 0; group < numChannels; group += channelLanes) {
+        const int groupSize = juce::jmin(channelLanes, numChannels - group);
+        auto z1 = Float4::load(keyZ1.data() + group);
+        auto z2 = Float4::load(keyZ2.data() + group);
+        float* levels = keyLevels.data() + group;
+
+        alignas(16) float frame[channelLanes] {};
+        for (int i = startSample; i < startSample + numSamples; ++i, levels += stride) {
+            for (int k = 0; k < groupSize; ++k)
+                frame[k] = static_cast<float>(channels[group + k][i]);
+
+            const auto x = Float4::load(frame);
+            const auto y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            Float4::abs(y).store(levels);
+        }
+
+        z1.store(keyZ1.data() + group);
+        z2.store(keyZ2.data() + group);
+    }
+}
+
+template <typename SampleType>
+void SidechainCompressor::process(SampleType* const* channels, int numChannels, int numSamples) {
+    numChannels = juce::jmin(numChannels, numPreparedChannels);
+    if (numChannels <= 0)
+        return;
+
+    updateSettings(loadSettings());
+
+    const bool rms = static_cast<DetectorMode>(detectorMode.load()) == DetectorMode::Rms;
+    const auto link = static_cast<LinkMode>(linkMode.load());
+    if (rms != rmsActive || link != activeLink)
+        restartDetection(link, rms);
+
+    // A new look-ahead step, as a fresh prepare() would start it
+    if (const int wanted = lookaheadSamples(lookaheadMs.load(), currentSampleRate); wanted != lookahead) {
+        lookahead = wanted;
+        clearLookahead();
+    }
+
+    const bool delay = lookahead > 0;
+    const auto wet = static_cast<SampleType>(dryWet.load());
+    const auto dry = SampleType(1) - wet;
+    const auto stride = static_cast<size_t>(paddedChannels(numPreparedChannels));
+    const auto invChannels = 1.0f / static_cast<float>(numChannels);
+
+    for (int start = 0; start < numSamples; start += maxBlockSize) {
+        const int blockLen = juce::jmin(maxBlockSize, numSamples - start);
+
+        filterKeys(channels, start, numChannels, blockLen);
+        if (rms)
+            rmsLevels(numChannels, blockLen);
+
+        // Detection + gain, one frame at a time (the envelope is recursive).
+        // With look-ahead the detector takes the peak of the window and the
+        // gain lands on the sample leaving the delay line.
+        const float* levels = keyLevels.data();
+        for (int i = start; i < start + blockLen; ++i, levels += stride, ++frameCounter) {
+            if (link == LinkMode::Unlinked) {
+                for (int ch = 0; ch < numChannels; ++ch) {
+                    const auto idx = static_cast<size_t>(ch);
+                    const float level = delay ? windowPeak(ch, levels[idx]) : levels[idx];
+                    const auto gainLin = static_cast<SampleType>(envelopeToGain(envelopes[idx], level));
+                    SampleType& s = channels[ch][i];
+                    const SampleType x = delay ? delayed(ch, s) : s;
+                    s = x * dry + (x * gainLin) * wet;
+                }
+            } else {
+                float level = 0.0f;
+                for (int ch = 0; ch < numChannels; ++ch)
+                    level = link == LinkMode::LinkedMax ? juce::jmax(level, levels[ch]) : level + levels[ch];
+                if (link == LinkMode::LinkedMean)
+                    level *= invChannels;
+                if (delay)
+                    level = windowPeak(0, level);
+
+                const auto gainLin = static_cast<SampleType>(envelopeToGain(envelopes[0], level));
+                const SampleType g = dry + gainLin * wet;
+                for (int ch = 0; ch < numChannels; ++ch)
+                    channels[ch][i] = (delay ? delayed(ch, channels[ch][i]) : channels[ch][i]) * g;
+            }
+        }
     }
 }
+
+template void SidechainCompressor::process(float* const*, int, int);
+template void SidechainCompressor::process(double* const*, int, int);
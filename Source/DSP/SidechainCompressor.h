@@ -1,22 +1,34 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include <vector>
 #include <atomic>
 #include <cmath>
+#include <cstdint>
+#include "SharedDspCache.h"
 
 // ============================================================================
 // SidechainCompressor
-// Responsibility: RMS envelope tracking + soft-knee compression for ducking.
+// Responsibility: Peak / RMS envelope tracking + soft-knee compression for
+// ducking, linked or per channel, with optional look-ahead. Per-channel
+// state lives in contiguous arrays; the key filter runs across channels in
+// SIMD lanes and the gain curve is a table, so no log/pow runs per sample.
 // ============================================================================
 class SidechainCompressor {
 public:
-    SidechainCompressor();
+    enum class LinkMode { Unlinked = 0, LinkedMax, LinkedMean };
+    enum class DetectorMode { Peak = 0, Rms };
 
-    void prepare(double sampleRate, int samplesPerBlock);
+    SidechainCompressor() = default;
+
+    void prepare(double sampleRate, int samplesPerBlock, int numChannels);
     void reset();
 
-    // Process data in-place, using sidechainInput as the key signal.
-    void process(float* data, const float* sidechainInput, int numSamples);
+    // Process channels in-place; each channel's input is also its key signal.
+    // Instantiated for float and double: gains are applied in the buffer's
+    // own precision, key filtering and envelopes run in float.
+    template <typename SampleType>
+    void process(SampleType* const* channels, int numChannels, int numSamples);
 
     // Thread-safe parameter setters
     void setAttackMs(float ms)    { attackMs.store(ms); }
@@ -24,13 +36,69 @@ public:
     void setDryWet(float w)       { dryWet.store(w); }
     void setThresholdDb(float db) { thresholdDb.store(db); }
     void setRatio(float r)        { ratio.store(r); }
+    void setKneeWidthDb(float db) { kneeWidthDb.store(db); }
+    void setLinkMode(LinkMode m)  { linkMode.store(static_cast<int>(m)); }
+    void setDetectorMode(DetectorMode m) { detectorMode.store(static_cast<int>(m)); }
+
+    // Look-ahead delays the audio so the envelope reaches a transient before
+    // it plays. Thread-safe: the delay line is sized for maxLookaheadMs in
+    // prepare(), and a new value takes effect at the start of the next
+    // process() call, restarting the delay and peak windows from silence.
+    void setLookaheadMs(float ms) { lookaheadMs.store(ms); }
+
+    // The look-ahead settings offered to the user, and the delay in samples
+    // one adds at a sample rate; this is the latency to report to the host
+    static constexpr std::array<float, 6> lookaheadStepsMs { 0.0f, 1.0f, 2.0f, 5.0f, 10.0f, 20.0f };
+    static constexpr float maxLookaheadMs = lookaheadStepsMs.back();
+    static int lookaheadSamples(float ms, double sampleRate) noexcept;
+
+    // Length of the RMS detector's window; converted to samples in prepare()
+    static constexpr float rmsWindowMs = 10.0f;
 
 private:
+    // Parameter snapshot taken once per block; derived values are only
+    // recomputed when it differs from the previous block's.
+    struct Settings {
+        float attackMs, releaseMs, thresholdDb, ratio, kneeWidthDb;
+    };
+
+    // Gain table: 2^gainTableOctaveBits linear segments per octave of
+    // envelope level, from 2^gainTableMinExponent (below the -100 dB floor)
+    // up to 2^gainTableMaxExponent (+24 dB). Levels above use exactGain().
+    // Interpolation follows the curve closely, except inside the one segment
+    // holding a corner of the curve, where a hard knee is rounded off; the
+    // SidechainCompressor benchmark suite checks the error against exactGain.
+    static constexpr int gainTableOctaveBits  = 5;
+    static constexpr int gainTableMinExponent = -17;
+    static constexpr int gainTableMaxExponent = 4;
+    static constexpr int gainTableSize = ((gainTableMaxExponent - gainTableMinExponent) << gainTableOctaveBits) + 1;
+
+    Settings loadSettings() const;
+    void updateSettings(const Settings& s);
+    void buildGainTable();
     float computeGainReduction(float levelDb) const;
+    float exactGain(float envelope) const;
+    float lookupGain(float envelope) const noexcept;
+    float envelopeToGain(float& envelope, float level) const noexcept;
+    template <typename SampleType>
+    void filterKeys(const SampleType* const* channels, int startSample, int numChannels, int numSamples) noexcept;
+    void clearLookahead();
+    float windowPeak(int detector, float level) noexcept;
+    template <typename SampleType>
+    SampleType delayed(int channel, SampleType input) noexcept;
+    void resetRms();
+    void restartDetection(LinkMode link, bool rms) noexcept;
+    void rmsLevels(int numChannels, int numSamples) noexcept;
 
     double currentSampleRate = 44100.0;
-    float envelopeLevel = 0.0f;
+    Settings active {};
+    bool settingsValid = false;
+
+    // Derived from `active`
     float attackCoeff = 0.01f, releaseCoeff = 0.001f;
+    float kneeStartDb = 0.0f, kneeEndDb = 0.0f;
+    float slope = 0.0f, kneeScale = 0.0f;
+    std::array<float, gainTableSize> gainTable {};
 
     std::atomic<float> attackMs    { 10.0f };
     std::atomic<float> releaseMs   { 100.0f };
@@ -38,12 +106,49 @@ private:
     std::atomic<float> thresholdDb { -18.0f };
     std::atomic<float> ratio       { 4.0f };
     std::atomic<float> kneeWidthDb { 6.0f };
+    std::atomic<int>   linkMode    { static_cast<int>(LinkMode::LinkedMax) };
+    std::atomic<float> lookaheadMs { 0.0f };
+    std::atomic<int>   detectorMode { static_cast<int>(DetectorMode::Peak) };
+
+    // Sidechain band-pass, shared coefficients [b0, b1, b2, a1, a2]; the
+    // cached set is held so other instances at this rate reuse it
+    std::array<float, 5> keyCoeffs {};
+    std::shared_ptr<const SharedDspCache::Coefficients> keyFilter;
+    juce::SharedResourcePointer<SharedDspCache> dspCache;
 
-    juce::dsp::IIR::Filter<float> sidechainFilter;
+    // Per-channel state, padded to whole SIMD groups of channels
+    int numPreparedChannels = 0;
+    int maxBlockSize = 0;
+    std::vector<float> keyZ1, keyZ2;   // filter state, one lane per channel
+    std::vector<float> keyLevels;      // |filtered key|, [sample][padded channel]
+    std::vector<float> envelopes;      // one per channel (only [0] when linked)
 
-    std::vector<float> rmsBuffer;
+    // Look-ahead: `lookahead` samples of delay in a ring of `delayLength` (a
+    // power of two above the longest step). The line is double so the 64-bit path stays
+    // exact. Each detector (channel, or [0] when linked) keeps a monotonic
+    // deque of (frame, level) whose front is the peak of the window spanning
+    // the delay, O(1) amortised per sample.
+    int lookahead = 0;
+    int delayLength = 1;
+    std::uint32_t frameCounter = 0;
+    std::vector<double> delayLines;               // [channel][delayLength]
+    std::vector<std::uint32_t> peakFrames;        // [detector][delayLength]
+    std::vector<float> peakLevels;                // [detector][delayLength]
+    std::vector<std::uint32_t> peakHeads, peakTails;
+
+    // RMS detector: the last `rmsLength` squared key levels per channel,
+    // [position][channel], and their running sums. Squares of float levels
+    // are exact in double, so adding and later subtracting the same value
+    // only rounds the sum.
+    int rmsLength = 1;
     int rmsWritePos = 0;
-    float rmsSum = 0.0f;
+
+    // Detector and link mode the detection state above belongs to; any
+    // change restarts it (restartDetection)
+    bool rmsActive = false;
+    LinkMode activeLink = LinkMode::LinkedMax;
+    std::vector<double> rmsSquares;
+    std::vector<double> rmsSums;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SidechainCompressor)
 };
@@ -0,0 +1,153 @@
+#pragma once
+#include <JuceHeader.h>
+
+#if defined(__AVX__)
+ #include <immintrin.h>
+ #define SOLFEGGIO_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define SOLFEGGIO_SIMD_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+ #include <arm_neon.h>
+ #define SOLFEGGIO_SIMD_NEON 1
+#endif
+
+// ============================================================================
+// Simd::Float8 / Simd::Float4
+// Responsibility: Eight (four) float lanes with the handful of operations the
+// DSP kernels need. Float8 maps to one AVX register or two SSE/NEON
+// registers; Float4 to one SSE/NEON register. Plain arrays are the fallback.
+// The choice is made at compile time from the architecture flags in
+// CMakeLists. Loads and stores are unaligned so callers can point anywhere in
+// a buffer.
+// ============================================================================
+namespace Simd {
+
+    struct Float8 {
+        static constexpr int width = 8;
+
+#if SOLFEGGIO_SIMD_AVX
+        __m256 v;
+
+        static Float8 load(const float* p) noexcept     { return { _mm256_loadu_ps(p) }; }
+        static Float8 broadcast(float x) noexcept       { return { _mm256_set1_ps(x) }; }
+        void store(float* p) const noexcept             { _mm256_storeu_ps(p, v); }
+
+        friend Float8 operator+(Float8 a, Float8 b) noexcept { return { _mm256_add_ps(a.v, b.v) }; }
+        friend Float8 operator-(Float8 a, Float8 b) noexcept { return { _mm256_sub_ps(a.v, b.v) }; }
+        friend Float8 operator*(Float8 a, Float8 b) noexcept { return { _mm256_mul_ps(a.v, b.v) }; }
+
+        static Float8 min(Float8 a, Float8 b) noexcept  { return { _mm256_min_ps(a.v, b.v) }; }
+        static Float8 max(Float8 a, Float8 b) noexcept  { return { _mm256_max_ps(a.v, b.v) }; }
+        static Float8 abs(Float8 a) noexcept            { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+#elif SOLFEGGIO_SIMD_SSE
+        __m128 lo, hi;
+
+        static Float8 load(const float* p) noexcept     { return { _mm_loadu_ps(p), _mm_loadu_ps(p + 4) }; }
+        static Float8 broadcast(float x) noexcept       { return { _mm_set1_ps(x), _mm_set1_ps(x) }; }
+        void store(float* p) const noexcept             { _mm_storeu_ps(p, lo); _mm_storeu_ps(p + 4, hi); }
+
+        friend Float8 operator+(Float8 a, Float8 b) noexcept { return { _mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi) }; }
+        friend Float8 operator-(Float8 a, Float8 b) noexcept { return { _mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi) }; }
+        friend Float8 operator*(Float8 a, Float8 b) noexcept { return { _mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi) }; }
+
+        static Float8 min(Float8 a, Float8 b) noexcept  { return { _mm_min_ps(a.lo, b.lo), _mm_min_ps(a.hi, b.hi) }; }
+        static Float8 max(Float8 a, Float8 b) noexcept  { return { _mm_max_ps(a.lo, b.lo), _mm_max_ps(a.hi, b.hi) }; }
+        static Float8 abs(Float8 a) noexcept {
+            const auto sign = _mm_set1_ps(-0.0f);
+            return { _mm_andnot_ps(sign, a.lo), _mm_andnot_ps(sign, a.hi) };
+        }
+#elif SOLFEGGIO_SIMD_NEON
+        float32x4_t lo, hi;
+
+        static Float8 load(const float* p) noexcept     { return { vld1q_f32(p), vld1q_f32(p + 4) }; }
+        static Float8 broadcast(float x) noexcept       { return { vdupq_n_f32(x), vdupq_n_f32(x) }; }
+        void store(float* p) const noexcept             { vst1q_f32(p, lo); vst1q_f32(p + 4, hi); }
+
+        friend Float8 operator+(Float8 a, Float8 b) noexcept { return { vaddq_f32(a.lo, b.lo), vaddq_f32(a.hi, b.hi) }; }
+        friend Float8 operator-(Float8 a, Float8 b) noexcept { return { vsubq_f32(a.lo, b.lo), vsubq_f32(a.hi, b.hi) }; }
+        friend Float8 operator*(Float8 a, Float8 b) noexcept { return { vmulq_f32(a.lo, b.lo), vmulq_f32(a.hi, b.hi) }; }
+
+        static Float8 min(Float8 a, Float8 b) noexcept  { return { vminq_f32(a.lo, b.lo), vminq_f32(a.hi, b.hi) }; }
+        static Float8 max(Float8 a, Float8 b) noexcept  { return { vmaxq_f32(a.lo, b.lo), vmaxq_f32(a.hi, b.hi) }; }
+        static Float8 abs(Float8 a) noexcept            { return { vabsq_f32(a.lo), vabsq_f32(a.hi) }; }
+#else
+        float x[width];
+
+        static Float8 load(const float* p) noexcept {
+            Float8 r;
+            for (int i = 0; i < width; ++i) r.x[i] = p[i];
+            return r;
+        }
+        static Float8 broadcast(float s) noexcept {
+            Float8 r;
+            for (auto& e : r.x) e = s;
+            return r;
+        }
+        void store(float* p) const noexcept {
+            for (int i = 0; i < width; ++i) p[i] = x[i];
+        }
+
+        friend Float8 operator+(Float8 a, Float8 b) noexcept { for (int i = 0; i < width; ++i) a.x[i] += b.x[i]; return a; }
+        friend Float8 operator-(Float8 a, Float8 b) noexcept { for (int i = 0; i < width; ++i) a.x[i] -= b.x[i]; return a; }
+        friend Float8 operator*(Float8 a, Float8 b) noexcept { for (int i = 0; i < width; ++i) a.x[i] *= b.x[i]; return a; }
+
+        static Float8 min(Float8 a, Float8 b) noexcept  { for (int i = 0; i < width; ++i) a.x[i] = juce::jmin(a.x[i], b.x[i]); return a; }
+        static Float8 max(Float8 a, Float8 b) noexcept  { for (int i = 0; i < width; ++i) a.x[i] = juce::jmax(a.x[i], b.x[i]); return a; }
+        static Float8 abs(Float8 a) noexcept            { for (auto& e : a.x) e = std::abs(e); return a; }
+#endif
+    };
+
+    struct Float4 {
+        static constexpr int width = 4;
+
+#if SOLFEGGIO_SIMD_AVX || SOLFEGGIO_SIMD_SSE
+        __m128 v;
+
+        static Float4 load(const float* p) noexcept     { return { _mm_loadu_ps(p) }; }
+        static Float4 broadcast(float x) noexcept       { return { _mm_set1_ps(x) }; }
+        void store(float* p) const noexcept             { _mm_storeu_ps(p, v); }
+
+        friend Float4 operator+(Float4 a, Float4 b) noexcept { return { _mm_add_ps(a.v, b.v) }; }
+        friend Float4 operator-(Float4 a, Float4 b) noexcept { return { _mm_sub_ps(a.v, b.v) }; }
+        friend Float4 operator*(Float4 a, Float4 b) noexcept { return { _mm_mul_ps(a.v, b.v) }; }
+
+        static Float4 abs(Float4 a) noexcept            { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+#elif SOLFEGGIO_SIMD_NEON
+        float32x4_t v;
+
+        static Float4 load(const float* p) noexcept     { return { vld1q_f32(p) }; }
+        static Float4 broadcast(float x) noexcept       { return { vdupq_n_f32(x) }; }
+        void store(float* p) const noexcept             { vst1q_f32(p, v); }
+
+        friend Float4 operator+(Float4 a, Float4 b) noexcept { return { vaddq_f32(a.v, b.v) }; }
+        friend Float4 operator-(Float4 a, Float4 b) noexcept { return { vsubq_f32(a.v, b.v) }; }
+        friend Float4 operator*(Float4 a, Float4 b) noexcept { return { vmulq_f32(a.v, b.v) }; }
+
+        static Float4 abs(Float4 a) noexcept            { return { vabsq_f32(a.v) }; }
+#else
+        float x[width];
+
+        static Float4 load(const float* p) noexcept {
+            Float4 r;
+            for (int i = 0; i < width; ++i) r.x[i] = p[i];
+            return r;
+        }
+        static Float4 broadcast(float s) noexcept {
+            Float4 r;
+            for (auto& e : r.x) e = s;
+            return r;
+        }
+        void store(float* p) const noexcept {
+            for (int i = 0; i < width; ++i) p[i] = x[i];
+        }
+
+        friend Float4 operator+(Float4 a, Float4 b) noexcept { for (int i = 0; i < width; ++i) a.x[i] += b.x[i]; return a; }
+        friend Float4 operator-(Float4 a, Float4 b) noexcept { for (int i = 0; i < width; ++i) a.x[i] -= b.x[i]; return a; }
+        friend Float4 operator*(Float4 a, Float4 b) noexcept { for (int i = 0; i < width; ++i) a.x[i] *= b.x[i]; return a; }
+
+        static Float4 abs(Float4 a) noexcept            { for (auto& e : a.x) e = std::abs(e); return a; }
+#endif
+    };
+
+} // namespace Simd
@@ -4,15 +4,21 @@ SmartAutoEngine::SmartAutoEngine() {}
 
 void SmartAutoEngine::prepare(double sr) {
     sampleRate = sr;
-    bassFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr, 300.0f);
-    midFilter.coefficients  = juce::dsp::IIR::Coefficients<float>::makeBandPass(sr, 800.0f, 0.8f);
-    highFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(sr, 2000.0f);
+    using Filter = SharedDspCache::Filter;
+    bandFilters = { dspCache->getBiquad(Filter::lowPass,  sr, 300.0f),
+                    dspCache->getBiquad(Filter::bandPass, sr, 800.0f, 0.8f),
+                    dspCache->getBiquad(Filter::highPass, sr, 2000.0f) };
+    for (int band : { bassBand, midBand, highBand })
+        bandAnalyser.setBand(band, *bandFilters[static_cast<size_t>(band)]);
+    bandAnalyser.reset();
+    crossfadeLength = static_cast<juce::int64>(std::llround(crossfadeDurationSec * sr));
     reset();
 }
 
 void SmartAutoEngine::reset() {
     smoothBass = smoothMid = smoothHigh = smoothTotal = 0.0f;
-    cycleTimer = 0.0;
+    cycleElapsed = 0;
+    crossfadeElapsed = 0;
     crossfadeProgress = 1.0f;
     isCrossfading = false;
     currentProfile = MusicProfile::Quiet;
@@ -41,14 +47,14 @@ void SmartAutoEngine::selectFrequenciesForProfile(MusicProfile profile,
         for (auto& idx : sel) idx = (idx + offset) % Solfeggio::NUM_FREQUENCIES;
 }
 
-void SmartAutoEngine::analyzeBlock(const float* data, int numSamples) {
-    float b = 0.0f, m = 0.0f, h = 0.0f;
-    for (int i = 0; i < numSamples; ++i) {
-        b += std::pow(bassFilter.processSample(data[i]), 2.0f);
-        m += std::pow(midFilter.processSample(data[i]),  2.0f);
-        h += std::pow(highFilter.processSample(data[i]), 2.0f);
-    }
+template <typename SampleType>
+void SmartAutoEngine::analyzeBlock(const SampleType* data, int numSamples) {
+    const auto energy = bandAnalyser.process(data, numSamples);
+    const float b = energy[bassBand], m = energy[midBand], h = energy[highBand];
     float invN = 1.0f / static_cast<float>(std::max(numSamples, 1));
+
+    // Time-based smoothing: the same ~0.3 s response whatever the block size
+    const auto smoothCoeff = static_cast<float>(std::exp(-numSamples / (energySmoothingSec * sampleRate)));
     smoothBass  = smoothCoeff * smoothBass  + (1.0f - smoothCoeff) * std::sqrt(b * invN);
     smoothMid   = smoothCoeff * smoothMid   + (1.0f - smoothCoeff) * std::sqrt(m * invN);
     smoothHigh  = smoothCoeff * smoothHigh  + (1.0f - smoothCoeff) * std::sqrt(h * invN);
@@ -56,27 +62,48 @@ void SmartAutoEngine::analyzeBlock(const float* data, int numSamples) {
     currentProfile = detectProfile();
 }
 
-void SmartAutoEngine::getTargetGains(std::array<float, Solfeggio::NUM_FREQUENCIES>& gains,
-                                      float cycleTimeSec, float intensity) {
-    constexpr double blockDur = 1.0 / 60.0;
-    cycleTimer += blockDur;
+template void SmartAutoEngine::analyzeBlock(const float*, int);
+template void SmartAutoEngine::analyzeBlock(const double*, int);
+
+void SmartAutoEngine::advanceCycle(float cycleTimeSec, int numSamples) {
+    cycleElapsed += numSamples;
+
+    // Samples of this span that fall after any crossfade finished — a new
+    // cycle can only start inside that window
+    juce::int64 idleSamples = numSamples;
 
     if (isCrossfading) {
-        crossfadeProgress += static_cast<float>(blockDur / crossfadeDurationSec);
-        if (crossfadeProgress >= 1.0f) {
-            crossfadeProgress = 1.0f;
+        crossfadeElapsed += numSamples;
+        idleSamples = std::max<juce::int64>(0, crossfadeElapsed - crossfadeLength);
+        if (crossfadeElapsed >= crossfadeLength) {
             isCrossfading = false;
             activeFreqs = nextFreqs;
         }
     }
 
-    if (cycleTimer >= static_cast<double>(cycleTimeSec) && !isCrossfading) {
-        cycleTimer = 0.0;
+    const auto cycleLength = static_cast<juce::int64>(std::llround(cycleTimeSec * sampleRate));
+    if (!isCrossfading && cycleElapsed >= cycleLength) {
+        // Carry the overshoot so the new cycle starts on its exact sample
+        const auto overshoot = std::min(cycleElapsed - cycleLength, idleSamples);
+        cycleElapsed = overshoot;
         ++currentCycleSlot;
         selectFrequenciesForProfile(currentProfile, nextFreqs);
-        if (nextFreqs != activeFreqs) { isCrossfading = true; crossfadeProgress = 0.0f; }
+        if (nextFreqs != activeFreqs) {
+            isCrossfading = true;
+            crossfadeElapsed = overshoot;
+        }
     }
 
+    crossfadeProgress = isCrossfading
+        ? juce::jmin(1.0f, static_cast<float>(static_cast<double>(crossfadeElapsed)
+                                              / static_cast<double>(crossfadeLength)))
+        : 1.0f;
+}
+
+void SmartAutoEngine::getTargetGains(std::array<float, Solfeggio::NUM_FREQUENCIES>& gains,
+                                      float cycleTimeSec, float intensity, int numSamples) {
+    advanceCycle(cycleTimeSec, numSamples);
+
     gains.fill(0.0f);
     float activeG = isCrossfading ? (1.0f - crossfadeProgress) : 1.0f;
     for (int i : activeFreqs) gains[static_cast<size_t>(i)] += activeG;
@@ -2,6 +2,8 @@
 #include <JuceHeader.h>
 #include <array>
 #include "Constants.h"
+#include "BandEnergyAnalyser.h"
+#include "SharedDspCache.h"
 
 // ============================================================================
 // SmartAutoEngine
@@ -15,12 +17,15 @@ public:
     void prepare(double sampleRate);
     void reset();
 
-    // Feed audio samples for spectral analysis
-    void analyzeBlock(const float* data, int numSamples);
+    // Feed audio samples for spectral analysis (float or double)
+    template <typename SampleType>
+    void analyzeBlock(const SampleType* data, int numSamples);
 
-    // Fill `gains` with target values for each frequency (0..1)
+    // Advance the cycle clock by `numSamples` and fill `gains` with the
+    // target values (0..1) at the end of that span. Timing is counted in
+    // samples, so it is identical at any block size and sample rate.
     void getTargetGains(std::array<float, Solfeggio::NUM_FREQUENCIES>& gains,
-                        float cycleTimeSec, float intensity);
+                        float cycleTimeSec, float intensity, int numSamples);
 
     enum class MusicProfile { BassHeavy, MidFocused, Bright, FullSpectrum, Quiet };
 
@@ -29,11 +34,15 @@ public:
 private:
     double sampleRate = 44100.0;
 
-    juce::dsp::IIR::Filter<float> bassFilter, midFilter, highFilter;
+    // Bass / mid / high biquads, filtered together in one SIMD pass
+    enum Band { bassBand, midBand, highBand };
+    BandEnergyAnalyser bandAnalyser;
+    std::array<std::shared_ptr<const SharedDspCache::Coefficients>, 3> bandFilters;   // held for sharing
+    juce::SharedResourcePointer<SharedDspCache> dspCache;
     float smoothBass = 0.0f, smoothMid = 0.0f, smoothHigh = 0.0f, smoothTotal = 0.0f;
-    static constexpr float smoothCoeff = 0.95f;
+    static constexpr double energySmoothingSec = 0.325;
 
-    double cycleTimer = 0.0;
+    juce::int64 cycleElapsed = 0;   // samples since the current cycle started
     int currentCycleSlot = 0;
     static constexpr int NUM_CYCLE_SLOTS = 3;
 
@@ -41,11 +50,14 @@ private:
     std::array<int, NUM_CYCLE_SLOTS> nextFreqs   = { 1, 6, 8 };
 
     float crossfadeProgress = 1.0f;
-    static constexpr float crossfadeDurationSec = 5.0f;
+    static constexpr double crossfadeDurationSec = 5.0;
+    juce::int64 crossfadeElapsed = 0;
+    juce::int64 crossfadeLength  = static_cast<juce::int64>(crossfadeDurationSec * 44100.0);
     bool isCrossfading = false;
 
     MusicProfile currentProfile = MusicProfile::Quiet;
 
+    void advanceCycle(float cycleTimeSec, int numSamples);
     MusicProfile detectProfile() const;
     void selectFrequenciesForProfile(MusicProfile profile,
                                      std::array<int, NUM_CYCLE_SLOTS>& selection);
@@ -1,86 +1,253 @@
 #include "SolfeggioEngine.h"
+#include "SimdLanes.h"
 
-SolfeggioEngine::SolfeggioEngine() {}
+namespace {
+
+    // out = music * (1 - 0.3 m) + solfeggio * m * duck with m = mix * send,
+    // where the duck gain follows the music level: clamp(1 - 0.5 |music|, 0.3, 1)
+    template <typename SampleType>
+    void mixAndDuck(SampleType* out, const float* solfeggio, const float* mix, float send, int numSamples) noexcept {
+        // Double music: same formula, left to the compiler to vectorise
+        for (int n = 0; n < numSamples; ++n) {
+            const SampleType music = out[n];
+            const SampleType m     = mix[n] * send;
+            const SampleType duck  = juce::jlimit(SampleType(0.3), SampleType(1), 1 - std::abs(music) * SampleType(0.5));
+            out[n] = music * (1 - m * SampleType(0.3)) + static_cast<SampleType>(solfeggio[n]) * m * duck;
+        }
+    }
+
+    template <>
+    void mixAndDuck(float* out, const float* solfeggio, const float* mix, float send, int numSamples) noexcept {
+        using Simd::Float8;
+        const auto sendV    = Float8::broadcast(send);
+        const auto one      = Float8::broadcast(1.0f);
+        const auto half     = Float8::broadcast(0.5f);
+        const auto dipDepth = Float8::broadcast(0.3f);
+        const auto duckMin  = Float8::broadcast(0.3f);
+
+        int n = 0;
+        for (; n + Float8::width <= numSamples; n += Float8::width) {
+            const auto music = Float8::load(out + n);
+            const auto m     = Float8::load(mix + n) * sendV;
+            const auto duck  = Float8::max(duckMin, Float8::min(one, one - Float8::abs(music) * half));
+            (music * (one - m * dipDepth) + Float8::load(solfeggio + n) * m * duck).store(out + n);
+        }
+
+        for (; n < numSamples; ++n) {
+            const float music = out[n];
+            const float m     = mix[n] * send;
+            const float duck  = juce::jlimit(0.3f, 1.0f, 1.0f - std::abs(music) * 0.5f);
+            out[n] = music * (1.0f - m * 0.3f) + solfeggio[n] * m * duck;
+        }
+    }
+
+    void fillRamp(juce::SmoothedValue<float>& smoother, float* dest, int numSamples, float scale) noexcept {
+        if (!smoother.isSmoothing()) {
+            juce::FloatVectorOperations::fill(dest, smoother.getTargetValue() * scale, numSamples);
+            return;
+        }
+        for (int n = 0; n < numSamples; ++n)
+            dest[n] = smoother.getNextValue() * scale;
+    }
+
+    // The controls a fraction t of the way from `from` to `to`
+    SolfeggioEngine::Controls interpolate(const SolfeggioEngine::Controls& from,
+                                          const SolfeggioEngine::Controls& to, float t) noexcept {
+        auto lerp = [t](float a, float b) { return a + (b - a) * t; };
+        SolfeggioEngine::Controls c;
+        c.cycleTime     = lerp(from.cycleTime, to.cycleTime);
+        c.autoIntensity = lerp(from.autoIntensity, to.autoIntensity);
+        for (size_t i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i)
+            c.manualGains[i] = lerp(from.manualGains[i], to.manualGains[i]);
+        c.masterMix     = lerp(from.masterMix, to.masterMix);
+        return c;
+    }
+
+} // namespace
+
+SolfeggioEngine::SolfeggioEngine() {
+    for (auto& send : channelSends)
+        send.store(1.0f);
+}
+
+void SolfeggioEngine::prepare(double sampleRate, int samplesPerBlock, int numChannels) {
+    maxBlockSize = juce::jmax(1, samplesPerBlock);
+    oscillatorBank.prepare(sampleRate);
+    gainRamps.setSize(Solfeggio::NUM_FREQUENCIES, maxBlockSize);
+    solfeggioBuffer.setSize(1, maxBlockSize);
+    mixRamp.setSize(1, maxBlockSize);
 
-void SolfeggioEngine::prepare(double sampleRate, int samplesPerBlock) {
     for (int i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i) {
         auto idx = static_cast<size_t>(i);
-        oscillators[idx].setFrequency(Solfeggio::Frequencies[idx], sampleRate);
         smoothedGains[idx].reset(sampleRate, 0.02);
         autoSmoothedGains[idx].reset(sampleRate, 0.05);
     }
-    sidechain.prepare(sampleRate, samplesPerBlock);
+    sidechain.prepare(sampleRate, samplesPerBlock, numChannels);
     autoEngine.prepare(sampleRate);
     smoothedMix.reset(sampleRate, 0.02);
-    fftFillIndex = 0;
-    fftInputBuffer.fill(0.0f);
-    fftData.fill(0.0f);
+    spectrum.prepare(sampleRate);
+    toneMeters.prepare(sampleRate);
+    profiler.prepare(sampleRate);
+    hasPreviousControls = false;
 }
 
 void SolfeggioEngine::reset() {
     sidechain.reset();
     autoEngine.reset();
+    toneMeters.reset();
+    hasPreviousControls = false;
 }
 
-void SolfeggioEngine::setSidechainParams(float attack, float release, float dryWet) {
+void SolfeggioEngine::setSidechainParams(float attack, float release, float dryWet,
+                                         SidechainCompressor::LinkMode linkMode,
+                                         SidechainCompressor::DetectorMode detectorMode) {
     sidechain.setAttackMs(attack);
     sidechain.setReleaseMs(release);
     sidechain.setDryWet(dryWet);
+    sidechain.setLinkMode(linkMode);
+    sidechain.setDetectorMode(detectorMode);
+}
+
+void SolfeggioEngine::setChannelSend(int channel, float send) noexcept {
+    if (channel >= 0 && channel < maxChannels)
+        channelSends[static_cast<size_t>(channel)].store(juce::jlimit(0.0f, 1.0f, send), std::memory_order_relaxed);
 }
 
-void SolfeggioEngine::process(juce::AudioBuffer<float>& buffer,
+float SolfeggioEngine::getChannelSend(int channel) const noexcept {
+    if (channel >= 0 && channel < maxChannels)
+        return channelSends[static_cast<size_t>(channel)].load(std::memory_order_relaxed);
+    return 1.0f;
+}
+
+template <typename SampleType>
+void SolfeggioEngine::process(juce::AudioBuffer<SampleType>& buffer,
                                bool autoMode,
                                float cycleTime,
                                float autoIntensity,
                                const std::array<float, Solfeggio::NUM_FREQUENCIES>& manualGains,
                                float masterMix)
+{
+    process(buffer, autoMode, Controls { cycleTime, autoIntensity, manualGains, masterMix });
+}
+
+template <typename SampleType>
+void SolfeggioEngine::process(juce::AudioBuffer<SampleType>& buffer, bool autoMode, const Controls& controls)
 {
     const int numSamples  = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
+    if (numSamples == 0)
+        return;
 
-    smoothedMix.setTargetValue(masterMix);
+    profiler.beginCallback(numSamples);
 
-    std::array<float, Solfeggio::NUM_FREQUENCIES> targetGains {};
     if (autoMode) {
+        EngineProfiler::ScopedStage probe(profiler, EngineProfiler::Stage::autoAnalysis);
         autoEngine.analyzeBlock(buffer.getReadPointer(0), numSamples);
-        autoEngine.getTargetGains(targetGains, cycleTime, autoIntensity);
-        for (size_t i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i)
-            autoSmoothedGains[i].setTargetValue(targetGains[i]);
-    } else {
-        for (size_t i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i)
-            smoothedGains[i].setTargetValue(manualGains[i]);
     }
 
-    for (int sample = 0; sample < numSamples; ++sample) {
-        const float mix = smoothedMix.getNextValue();
-        float solSample = 0.0f;
+    // The first block after prepare() / reset() has no line to follow
+    if (! hasPreviousControls)
+        previousControls = controls;
+    hasPreviousControls = true;
 
-        for (size_t i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i) {
-            float gain = autoMode ? autoSmoothedGains[i].getNextValue()
-                                  : smoothedGains[i].getNextValue();
-            if (gain > 0.001f)
-                solSample += oscillators[i].next() * gain * 0.1f;
-        }
+    // Render in chunks no longer than the scratch buffers prepared for
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+        renderChunk(buffer, start, juce::jmin(maxBlockSize, numSamples - start), autoMode, controls);
+    previousControls = controls;
+
+    // Stage 5 — sidechain compression, all channels in one pass
+    {
+        EngineProfiler::ScopedStage probe(profiler, EngineProfiler::Stage::sidechain);
+        sidechain.process(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+    }
+
+    // Stage 6 — per-tone levels of the final output, for the meters
+    {
+        EngineProfiler::ScopedStage probe(profiler, EngineProfiler::Stage::toneMeters);
+        toneMeters.process(buffer.getReadPointer(0), numSamples);
+    }
+
+    profiler.endCallback();
+}
 
-        for (int ch = 0; ch < numChannels; ++ch) {
-            float* out   = buffer.getWritePointer(ch);
-            float  music = out[sample];
-            float  sideGain = juce::jlimit(0.3f, 1.0f, 1.0f - (std::abs(music) * 0.5f));
-            out[sample] = music * (1.0f - mix * 0.3f) + solSample * mix * sideGain;
+template <typename SampleType>
+void SolfeggioEngine::renderChunk(juce::AudioBuffer<SampleType>& buffer, int startSample,
+                                  int numSamples, bool autoMode, const Controls& controls)
+{
+    // Stage 1 — gain ramps. Controls and auto-mode targets are re-evaluated
+    // every controlInterval samples, so automation, cycling and crossfades
+    // advance on the real sample count, independent of the host block size.
+    // Each segment aims at the controls' line where the segment ends.
+    auto& voiceSmoothers = autoMode ? autoSmoothedGains : smoothedGains;
+    std::array<bool, Solfeggio::NUM_FREQUENCIES> voiceActive {};
+    float* mix = mixRamp.getWritePointer(0);
+    const auto blockLength = static_cast<float>(buffer.getNumSamples());
+    EngineProfiler::ScopedStage probe(profiler, EngineProfiler::Stage::gainRamps);
+
+    for (int seg = 0; seg < numSamples; seg += controlInterval) {
+        const int segLen = juce::jmin(controlInterval, numSamples - seg);
+
+        const auto current = interpolate(previousControls, controls,
+                                         static_cast<float>(startSample + seg + segLen) / blockLength);
+        smoothedMix.setTargetValue(current.masterMix);
+        fillRamp(smoothedMix, mix + seg, segLen, 1.0f);
+
+        if (autoMode) {
+            std::array<float, Solfeggio::NUM_FREQUENCIES> targetGains {};
+            autoEngine.getTargetGains(targetGains, current.cycleTime, current.autoIntensity, segLen);
+            for (size_t i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i)
+                autoSmoothedGains[i].setTargetValue(targetGains[i]);
+        } else {
+            for (size_t i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i)
+                smoothedGains[i].setTargetValue(current.manualGains[i]);
         }
 
-        // Feed FFT
-        fftInputBuffer[static_cast<size_t>(fftFillIndex)] = buffer.getSample(0, sample);
-        if (++fftFillIndex >= fftSize) {
-            fftFillIndex = 0;
-            std::copy(fftInputBuffer.begin(), fftInputBuffer.end(), fftData.begin());
-            std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
-            forwardFFT.performFrequencyOnlyForwardTransform(fftData.data());
-            fftDataReady.store(true, std::memory_order_release);
+        for (size_t i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i) {
+            auto& smoother = voiceSmoothers[i];
+            float* ramp = gainRamps.getWritePointer(static_cast<int>(i));
+
+            // A voice joins the active list at its first audible segment;
+            // until then it has no ramp to fill and costs nothing
+            if (! voiceActive[i]) {
+                if (! smoother.isSmoothing() && smoother.getTargetValue() <= silenceThreshold)
+                    continue;
+                voiceActive[i] = true;
+                juce::FloatVectorOperations::clear(ramp, seg);
+            }
+            fillRamp(smoother, ramp + seg, segLen, voiceLevel);
         }
     }
 
-    // Post-processing sidechain compression
-    for (int ch = 0; ch < numChannels; ++ch)
-        sidechain.process(buffer.getWritePointer(ch), buffer.getReadPointer(ch), numSamples);
+    // Voices left off the active list are skipped by the bank, which only
+    // advances their phase
+    std::array<const float*, Solfeggio::NUM_FREQUENCIES> voiceGains {};
+    for (size_t i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i)
+        if (voiceActive[i])
+            voiceGains[i] = gainRamps.getReadPointer(static_cast<int>(i));
+
+    // Stage 2 — summed oscillator signal
+    probe.switchTo(EngineProfiler::Stage::oscillators);
+    float* solfeggio = solfeggioBuffer.getWritePointer(0);
+    juce::FloatVectorOperations::clear(solfeggio, numSamples);
+    oscillatorBank.render(solfeggio, voiceGains.data(), numSamples);
+
+    // Stage 3 — mix and duck, one pass per channel through its send; a
+    // channel with no send is left as it came in
+    probe.switchTo(EngineProfiler::Stage::mix);
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+        const float send = getChannelSend(ch);
+        if (send > 0.0f)
+            mixAndDuck(buffer.getWritePointer(ch, startSample), solfeggio, mix, send, numSamples);
+    }
+
+    // Stage 4 — analysis feed (FFT runs on the analysis thread)
+    probe.switchTo(EngineProfiler::Stage::analysisFeed);
+    spectrum.pushSamples(buffer.getReadPointer(0, startSample), numSamples);
 }
+
+template void SolfeggioEngine::process(juce::AudioBuffer<float>&, bool, const SolfeggioEngine::Controls&);
+template void SolfeggioEngine::process(juce::AudioBuffer<double>&, bool, const SolfeggioEngine::Controls&);
+template void SolfeggioEngine::process(juce::AudioBuffer<float>&, bool, float, float,
+                                       const std::array<float, Solfeggio::NUM_FREQUENCIES>&, float);
+template void SolfeggioEngine::process(juce::AudioBuffer<double>&, bool, float, float,
+                                       const std::array<float, Solfeggio::NUM_FREQUENCIES>&, float);
@@ -3,20 +3,53 @@
 #include <array>
 #include <atomic>
 #include "Constants.h"
+#include "EngineProfiler.h"
+#include "GoertzelBank.h"
+#include "OscillatorBank.h"
 #include "SmartAutoEngine.h"
 #include "SidechainCompressor.h"
+#include "SpectrumAnalysis.h"
 
 // ============================================================================
 // SolfeggioEngine
-// Responsibility: Orchestrates all DSP — oscillators, FFT, auto engine, and
-// sidechain compressor. This is the "Model" in the MVC/MVVM sense.
+// Responsibility: Orchestrates all DSP — oscillators, spectrum feed, auto
+// engine, sidechain compressor and per-tone meters. The Solfeggio signal is
+// rendered once per block and mixed into each channel through its send, so
+// any channel layout costs one vectorised mix pass per channel.
+// This is the "Model" in the MVC/MVVM sense.
 // ============================================================================
 class SolfeggioEngine {
 public:
+    // Automatable controls, as the host holds them at a block
+    struct Controls {
+        float cycleTime     = 45.0f;
+        float autoIntensity = 0.6f;                                  // 0..1
+        std::array<float, Solfeggio::NUM_FREQUENCIES> manualGains {};  // 0 when a tone is off
+        float masterMix     = 0.0f;                                  // 0..1
+    };
+
+    // Granularity (samples) at which control and auto-mode gain targets are
+    // refreshed, whatever the host block size
+    static constexpr int controlInterval = 32;
+
     SolfeggioEngine();
 
-    void prepare(double sampleRate, int samplesPerBlock);
-    void process(juce::AudioBuffer<float>& buffer,
+    void prepare(double sampleRate, int samplesPerBlock, int numChannels);
+
+    // Instantiated for float and double buffers. The music is scaled, ducked
+    // and compressed in the buffer's own precision; the Solfeggio voices and
+    // all control signals are rendered in float, which carries them at far
+    // below audibility, so neither path converts the host's buffer.
+    // Every controlInterval samples the smoother targets move a step along
+    // the straight line from the previous block's controls to `controls`,
+    // so automation the host delivers once per block is not stepped at the
+    // block rate.
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, bool autoMode, const Controls& controls);
+
+    // The same controls for the whole buffer
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer,
                  bool autoMode,
                  float cycleTime,
                  float autoIntensity,
@@ -24,45 +57,69 @@ public:
                  float masterMix);
     void reset();
 
-    void setSidechainParams(float attack, float release, float dryWet);
+    void setSidechainParams(float attack, float release, float dryWet,
+                            SidechainCompressor::LinkMode linkMode,
+                            SidechainCompressor::DetectorMode detectorMode);
+
+    // Delays the whole output by SidechainCompressor::lookaheadSamples(ms,
+    // sampleRate) from the next process() call on; any thread
+    void setLookaheadMs(float ms) { sidechain.setLookaheadMs(ms); }
 
-    // FFT access for SpectrumAnalyzer (read-only, lock-free)
-    static constexpr int fftOrder = 11;
-    static constexpr int fftSize  = 1 << fftOrder;
-    const float* getFFTData() const { return fftData.data(); }
-    bool isFFTDataReady() { return fftDataReady.exchange(false); }
+    // Per-channel send of the Solfeggio mix (0..1, default 1). A send scales
+    // both the tones and the music dip on that channel, so 0 leaves the
+    // channel untouched (e.g. LFE). Any thread; channels at or above
+    // maxChannels always use 1.
+    static constexpr int maxChannels = 32;
+    void setChannelSend(int channel, float send) noexcept;
+    float getChannelSend(int channel) const noexcept;
+
+    // Spectrum frames for SpectrumAnalyzer (computed off the audio thread)
+    SpectrumAnalysis& getSpectrum() { return spectrum; }
 
     const SmartAutoEngine& getAutoEngine() const { return autoEngine; }
 
+    // Output level at each Solfeggio frequency, for the per-tone meters
+    const GoertzelBank& getToneMeters() const { return toneMeters; }
+
+    // Per-stage timings (all zero unless built with SOLFEGGIO_PROFILING)
+    const EngineProfiler& getProfiler() const { return profiler; }
+
 private:
-    struct SineOscillator {
-        float phase = 0.0f, phaseIncrement = 0.0f;
-        void setFrequency(float freq, double sr) {
-            phaseIncrement = freq * juce::MathConstants<float>::twoPi / static_cast<float>(sr);
-        }
-        float next() {
-            float s = std::sin(phase);
-            phase += phaseIncrement;
-            if (phase > juce::MathConstants<float>::twoPi)
-                phase -= juce::MathConstants<float>::twoPi;
-            return s;
-        }
-    };
+    // One pass of the block pipeline over at most maxBlockSize samples:
+    // gain ramps -> oscillator bank -> per-channel mix/duck -> analysis feed
+    template <typename SampleType>
+    void renderChunk(juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                     bool autoMode, const Controls& controls);
+
+    // Per-voice output level before the gain ramp (headroom for 10 voices)
+    static constexpr float voiceLevel = 0.1f;
+
+    // Target gain at or below which a settled voice counts as silent
+    static constexpr float silenceThreshold = 0.001f;
 
-    std::array<SineOscillator, Solfeggio::NUM_FREQUENCIES>          oscillators;
+    OscillatorBank oscillatorBank;
     std::array<juce::SmoothedValue<float>, Solfeggio::NUM_FREQUENCIES> smoothedGains;
     std::array<juce::SmoothedValue<float>, Solfeggio::NUM_FREQUENCIES> autoSmoothedGains;
     juce::SmoothedValue<float> smoothedMix;
 
+    // The controls the previous block ended on, where this block's line starts
+    Controls previousControls;
+    bool hasPreviousControls = false;
+
+    // Scratch buffers sized once in prepare(): per-voice gain ramps, the
+    // master-mix ramp, and the summed Solfeggio signal for the current chunk
+    int maxBlockSize = 512;
+    juce::AudioBuffer<float> gainRamps;
+    juce::AudioBuffer<float> mixRamp;
+    juce::AudioBuffer<float> solfeggioBuffer;
+
+    std::array<std::atomic<float>, maxChannels> channelSends;
+
     SidechainCompressor sidechain;
     SmartAutoEngine     autoEngine;
-
-    // FFT state
-    juce::dsp::FFT forwardFFT { fftOrder };
-    int fftFillIndex = 0;
-    std::array<float, fftSize>     fftInputBuffer {};
-    std::array<float, fftSize * 2> fftData        {};
-    std::atomic<bool>              fftDataReady   { false };
+    SpectrumAnalysis    spectrum;
+    GoertzelBank        toneMeters;
+    EngineProfiler      profiler;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SolfeggioEngine)
 };
@@ -0,0 +1,128 @@
+#include "SpectrumAnalysis.h"
+
+SpectrumAnalysis::SpectrumAnalysis() {}
+
+SpectrumAnalysis::~SpectrumAnalysis() {
+    stopAnalysis();
+}
+
+void SpectrumAnalysis::prepare(double sr) {
+    sampleRate.store(sr);
+}
+
+void SpectrumAnalysis::pushSamples(const float* data, int numSamples) noexcept {
+    ring.push(data, numSamples);
+}
+
+void SpectrumAnalysis::pushSamples(const double* data, int numSamples) noexcept {
+    std::array<float, 256> chunk;
+    for (int start = 0; start < numSamples; start += static_cast<int>(chunk.size())) {
+        const int count = juce::jmin(static_cast<int>(chunk.size()), numSamples - start);
+        for (int i = 0; i < count; ++i)
+            chunk[static_cast<size_t>(i)] = static_cast<float>(data[start + i]);
+        ring.push(chunk.data(), count);
+    }
+}
+
+void SpectrumAnalysis::startAnalysis() {
+    if (!running.exchange(true))
+        thread->addTimeSliceClient(this);
+}
+
+void SpectrumAnalysis::stopAnalysis() {
+    if (running.exchange(false))
+        thread->removeTimeSliceClient(this);
+}
+
+void SpectrumAnalysis::setSettings(const Settings& newSettings) {
+    requestedOrder.store(juce::jlimit(minFftOrder, maxFftOrder, newSettings.fftOrder));
+    requestedWindow.store(static_cast<int>(newSettings.window));
+    requestedOverlap.store(juce::jlimit(0.5f, 0.875f, newSettings.overlap));
+    requestedAveraging.store(juce::jmax(0.0f, newSettings.averagingMs));
+    settingsVersion.fetch_add(1);
+}
+
+SpectrumAnalysis::Settings SpectrumAnalysis::getSettings() const noexcept {
+    Settings s;
+    s.fftOrder    = requestedOrder.load();
+    s.window      = static_cast<Window>(requestedWindow.load());
+    s.overlap     = requestedOverlap.load();
+    s.averagingMs = requestedAveraging.load();
+    return s;
+}
+
+void SpectrumAnalysis::applySettings() {
+    appliedVersion = settingsVersion.load();
+
+    const int order = requestedOrder.load();
+    const float overlap = requestedOverlap.load();
+    averagingMs = requestedAveraging.load();
+
+    if (forwardFFT == nullptr || forwardFFT->getSize() != (1 << order)) {
+        fftSize = 1 << order;
+        forwardFFT = dspCache->getFft(order);
+        history.assign(static_cast<size_t>(fftSize), 0.0f);
+        fftData.assign(static_cast<size_t>(fftSize * 2), 0.0f);
+        historyFill = 0;
+    }
+
+    const auto type = static_cast<Window>(requestedWindow.load()) == Window::blackmanHarris
+                    ? juce::dsp::WindowingFunction<float>::blackmanHarris
+                    : juce::dsp::WindowingFunction<float>::hann;
+    window = dspCache->getWindow(type, fftSize, true);
+
+    hopSize = juce::jmax(1, juce::roundToInt(static_cast<float>(fftSize) * (1.0f - overlap)));
+    power.assign(static_cast<size_t>(fftSize / 2), 0.0f);
+}
+
+int SpectrumAnalysis::useTimeSlice() {
+    if (appliedVersion != settingsVersion.load())
+        applySettings();
+
+    const int ready = ring.getNumReady();
+    if (ready < hopSize)
+        return 10;
+
+    // Only the newest frame is worth drawing: with a backlog of a whole
+    // frame or more, refill the history from the newest samples and drop
+    // the rest; otherwise slide it along by one hop.
+    float* hist = history.data();
+    if (ready >= fftSize) {
+        ring.pop(nullptr, ready - fftSize);
+        ring.pop(hist, fftSize);
+        historyFill = fftSize;
+    } else {
+        std::memmove(hist, hist + hopSize, static_cast<size_t>(fftSize - hopSize) * sizeof(float));
+        ring.pop(hist + fftSize - hopSize, hopSize);
+        historyFill = juce::jmin(fftSize, historyFill + hopSize);
+    }
+
+    if (historyFill < fftSize)
+        return 0;
+
+    std::copy(history.begin(), history.end(), fftData.begin());
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+    juce::FloatVectorOperations::multiply(fftData.data(), window->data(), fftSize);
+    forwardFFT->performFrequencyOnlyForwardTransform(fftData.data());
+
+    // The window is normalised to unit mean, so a full-scale sine peaks at
+    // fftSize / 2; exponential averaging runs on power, one step per hop
+    const double sr = sampleRate.load();
+    const float scale = 2.0f / static_cast<float>(fftSize);
+    const float keep = averagingMs > 0.0f
+                     ? static_cast<float>(std::exp(-1000.0 * hopSize / (sr * averagingMs)))
+                     : 0.0f;
+
+    const int numBins = fftSize / 2;
+    auto& frame = frames.getWriteBuffer();
+    for (size_t b = 0; b < static_cast<size_t>(numBins); ++b) {
+        const float m = fftData[b] * scale;
+        power[b] = keep * power[b] + (1.0f - keep) * m * m;
+        frame.magnitudes[b] = std::sqrt(power[b]);
+    }
+    frame.numBins = numBins;
+    frame.sampleRate = sr;
+    frames.publish();
+
+    return ring.getNumReady() >= hopSize ? 0 : 10;
+}
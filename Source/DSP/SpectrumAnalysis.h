@@ -0,0 +1,106 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "SharedDspCache.h"
+#include "SpscRingBuffer.h"
+#include "TripleBuffer.h"
+
+// ============================================================================
+// SpectrumAnalysis
+// Responsibility: Spectrum data for the GUI without FFT work on the audio
+// thread. The audio thread only pushes raw samples into a lock-free ring;
+// a shared background thread runs the windowed FFT and publishes finished
+// frames through a triple buffer that the editor reads from its timer.
+// Analysis only runs while an editor has called startAnalysis().
+//
+// FFT size (1024-16384), window, overlap and exponential averaging are set
+// from the message thread and picked up by the analysis thread before its
+// next frame. The audio thread's cost is one ring push whatever the
+// settings; the analysis thread runs at most one FFT per time slice, so a
+// large size cannot starve other plugin instances sharing the thread.
+// Magnitudes are scaled so a full-scale sine reads 1.0 at any FFT size.
+// ============================================================================
+class SpectrumAnalysis : private juce::TimeSliceClient {
+public:
+    static constexpr int minFftOrder = 10;
+    static constexpr int maxFftOrder = 14;
+    static constexpr int maxFftSize  = 1 << maxFftOrder;
+    static constexpr int maxNumBins  = maxFftSize / 2;
+
+    enum class Window { hann, blackmanHarris };
+
+    struct Settings {
+        int    fftOrder    = 13;              // 2^order points, minFftOrder..maxFftOrder
+        Window window      = Window::hann;
+        float  overlap     = 0.75f;           // 0.5..0.875 of a frame shared with the last one
+        float  averagingMs = 100.0f;          // exponential averaging time constant, 0 = off
+    };
+
+    struct Frame {
+        std::array<float, maxNumBins> magnitudes {};   // linear, 1.0 = full-scale sine
+        int numBins = 0;
+        double sampleRate = 44100.0;
+    };
+
+    SpectrumAnalysis();
+    ~SpectrumAnalysis() override;
+
+    void prepare(double sampleRate);
+
+    // Audio thread — never blocks; drops samples if the consumer falls behind.
+    // Double input is narrowed on the way in: the display needs no more.
+    void pushSamples(const float* data, int numSamples) noexcept;
+    void pushSamples(const double* data, int numSamples) noexcept;
+
+    // Message thread — attach/detach the background consumer
+    void startAnalysis();
+    void stopAnalysis();
+
+    // Message thread — takes effect from the next analysed frame
+    void setSettings(const Settings& newSettings);
+    Settings getSettings() const noexcept;
+
+    // Message thread — picks up the newest frame, true if one arrived
+    bool fetchLatestFrame() noexcept { return frames.fetch(); }
+    const Frame& getLatestFrame() const noexcept { return frames.getReadBuffer(); }
+
+private:
+    // One background thread shared by every plugin instance in the process
+    struct AnalysisThread : juce::TimeSliceThread {
+        AnalysisThread() : juce::TimeSliceThread("Solfeggio Spectrum") { startThread(Priority::low); }
+        ~AnalysisThread() override { stopThread(2000); }
+    };
+
+    int useTimeSlice() override;
+    void applySettings();
+
+    SpscRingBuffer<float> ring { maxFftSize * 2 };
+    std::atomic<double>   sampleRate { 44100.0 };
+    std::atomic<bool>     running    { false };
+
+    // Written by the message thread; `settingsVersion` is bumped last
+    std::atomic<int>   requestedOrder     { Settings{}.fftOrder };
+    std::atomic<int>   requestedWindow    { static_cast<int>(Settings{}.window) };
+    std::atomic<float> requestedOverlap   { Settings{}.overlap };
+    std::atomic<float> requestedAveraging { Settings{}.averagingMs };
+    std::atomic<int>   settingsVersion    { 1 };
+
+    // Owned by the analysis thread; resized only in applySettings()
+    int appliedVersion = 0;
+    int fftSize = 0, hopSize = 0, historyFill = 0;
+    float averagingMs = 0.0f;
+    std::shared_ptr<const juce::dsp::FFT> forwardFFT;              // shared plan, see SharedDspCache
+    std::shared_ptr<const SharedDspCache::Table> window;
+    std::vector<float> history;    // the last fftSize input samples
+    std::vector<float> fftData;    // 2 * fftSize work buffer
+    std::vector<float> power;      // averaged power per bin
+
+    TripleBuffer<Frame> frames;
+    juce::SharedResourcePointer<AnalysisThread> thread;
+    juce::SharedResourcePointer<SharedDspCache> dspCache;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalysis)
+};
@@ -4,6 +4,7 @@
 #include "SmartAutoEngine.h"
 #include "SolfeggioProcessor.h"
 #include <JuceHeader.h>
+#include <optional>
 
 class AutoModeBar : public juce::Component {
 public:
@@ -59,23 +60,22 @@ public:
     addAndMakeVisible(profileLabel);
   }
 
-  void updateVisibility() {
-    bool autoOn = processor.apvts.getRawParameterValue(Solfeggio::Params::autoMode.getParamID())->load() > 0.5f;
-    
-    cycleTimeSlider.setVisible(autoOn);
-    cycleTimeLabel.setVisible(autoOn);
-    autoIntensitySlider.setVisible(autoOn);
-    autoIntensityLabel.setVisible(autoOn);
-    profileLabel.setVisible(autoOn);
+  // Applies a new view-model state; only the parts that changed are touched.
+  // Layout does not depend on visibility, so no resized() is needed here.
+  void update(const EditorViewModel::State &state) {
+    if (state.autoMode != shownAutoMode) {
+      shownAutoMode = state.autoMode;
+      cycleTimeSlider.setVisible(state.autoMode);
+      cycleTimeLabel.setVisible(state.autoMode);
+      autoIntensitySlider.setVisible(state.autoMode);
+      autoIntensityLabel.setVisible(state.autoMode);
+      profileLabel.setVisible(state.autoMode);
+    }
 
-    if (autoOn) {
-      auto profile = processor.engine.getAutoEngine().getCurrentProfile();
-      profileLabel.setText("Profile: " + getProfileText(profile), juce::dontSendNotification);
+    if (state.profile != shownProfile) {
+      shownProfile = state.profile;
+      profileLabel.setText("Profile: " + getProfileText(state.profile), juce::dontSendNotification);
     }
-    
-    // Ensure layout is refreshed if state changed
-    resized();
-    repaint();
   }
 
   void resized() override {
@@ -109,6 +109,11 @@ private:
   }
 
   SolfeggioProcessor &processor;
+
+  // Last state applied by update(); empty until the first call sets everything
+  std::optional<bool> shownAutoMode;
+  std::optional<SmartAutoEngine::MusicProfile> shownProfile;
+
   juce::ToggleButton autoModeButton;
   juce::Slider cycleTimeSlider, autoIntensitySlider;
   juce::Label cycleTimeLabel, autoIntensityLabel, profileLabel;
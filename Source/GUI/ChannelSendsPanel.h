@@ -0,0 +1,120 @@
+#pragma once
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "LookAndFeel.h"
+#include "SolfeggioProcessor.h"
+
+// ============================================================================
+// ChannelSendsPanel (GUI/View layer)
+// Responsibility: One send slider per channel of the current output layout,
+// shown over the spectrum. Sends are stored per channel type in the plugin
+// state, so the sliders are rebuilt whenever the host changes the layout.
+// ============================================================================
+class ChannelSendsPanel : public juce::Component, private juce::Timer {
+public:
+    explicit ChannelSendsPanel(SolfeggioProcessor& p) : processor(p) {}
+
+    void visibilityChanged() override {
+        if (isVisible()) {
+            refresh();
+            startTimerHz(4);
+        } else {
+            stopTimer();
+        }
+    }
+
+    void paint(juce::Graphics& g) override {
+        using Colors = SolfeggioLookAndFeel::Colors;
+        auto bounds = getLocalBounds().toFloat();
+
+        g.setColour(Colors::background.withAlpha(0.92f));
+        g.fillRoundedRectangle(bounds, 8.0f);
+        g.setColour(Colors::surface);
+        g.drawRoundedRectangle(bounds.reduced(0.5f), 8.0f, 1.0f);
+
+        g.setFont(juce::Font(juce::FontOptions(11.0f).withStyle("Bold")));
+        g.setColour(Colors::gold);
+        g.drawText("CHANNEL SENDS  (" + layout.getDescription() + ")",
+                   getLocalBounds().reduced(12, 8).removeFromTop(titleHeight), juce::Justification::centredLeft);
+    }
+
+    void resized() override {
+        auto area = getLocalBounds().reduced(12, 8);
+        area.removeFromTop(titleHeight);
+        if (rows.empty())
+            return;
+
+        // Two columns once the rows would get too thin for a slider
+        const int columns = rows.size() > 6 ? 2 : 1;
+        const int perColumn = (static_cast<int>(rows.size()) + columns - 1) / columns;
+        const int rowHeight = juce::jmin(24, area.getHeight() / perColumn);
+        const int columnWidth = area.getWidth() / columns;
+
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const int column = static_cast<int>(i) / perColumn;
+            const int row    = static_cast<int>(i) % perColumn;
+            juce::Rectangle<int> cell(area.getX() + column * columnWidth, area.getY() + row * rowHeight,
+                                      columnWidth, rowHeight);
+            rows[i]->label.setBounds(cell.removeFromLeft(40));
+            rows[i]->slider.setBounds(cell.reduced(4, 2));
+        }
+    }
+
+private:
+    struct Row {
+        juce::AudioChannelSet::ChannelType type;
+        juce::Label  label;
+        juce::Slider slider;
+    };
+
+    void timerCallback() override { refresh(); }
+
+    // Rebuilds the rows after a layout change; otherwise picks up sends
+    // changed elsewhere (a loaded state), leaving a slider being dragged alone
+    void refresh() {
+        const auto current = processor.getChannelLayoutOfBus(false, 0);
+        if (current != layout) {
+            layout = current;
+            rebuild();
+        }
+
+        for (auto& row : rows)
+            if (! row->slider.isMouseButtonDown())
+                row->slider.setValue(processor.getChannelSend(row->type), juce::dontSendNotification);
+    }
+
+    void rebuild() {
+        rows.clear();
+        for (int ch = 0; ch < layout.size(); ++ch) {
+            auto row = std::make_unique<Row>();
+            row->type = layout.getTypeOfChannel(ch);
+
+            row->label.setText(juce::AudioChannelSet::getAbbreviatedChannelTypeName(row->type),
+                               juce::dontSendNotification);
+            row->label.setFont(juce::Font(juce::FontOptions(10.0f)));
+            row->label.setColour(juce::Label::textColourId, SolfeggioLookAndFeel::Colors::textSecondary);
+            addAndMakeVisible(row->label);
+
+            row->slider.setSliderStyle(juce::Slider::LinearHorizontal);
+            row->slider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 40, 16);
+            row->slider.setRange(0.0, 1.0, 0.01);
+            row->slider.onValueChange = [this, r = row.get()] {
+                processor.setChannelSend(r->type, static_cast<float>(r->slider.getValue()));
+            };
+            addAndMakeVisible(row->slider);
+
+            rows.push_back(std::move(row));
+        }
+        resized();
+        repaint();
+    }
+
+    static constexpr int titleHeight = 18;
+
+    SolfeggioProcessor& processor;
+    juce::AudioChannelSet layout;
+    std::vector<std::unique_ptr<Row>> rows;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelSendsPanel)
+};
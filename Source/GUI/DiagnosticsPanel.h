@@ -0,0 +1,85 @@
+#pragma once
+#include <JuceHeader.h>
+#include "EngineProfiler.h"
+#include "LookAndFeel.h"
+#include "SolfeggioProcessor.h"
+
+//==============================================================================
+// Per-stage DSP load, read from the engine's profiler. Each bar is the
+// stage's share of the real-time budget for one block, averaged over the
+// last profiling window; the text gives mean / worst time per callback.
+// Only useful in builds with SOLFEGGIO_PROFILING — the editor hides its
+// toggle otherwise.
+//==============================================================================
+class DiagnosticsPanel : public juce::Component, private juce::Timer {
+public:
+  explicit DiagnosticsPanel(SolfeggioProcessor &proc) : processor(proc) {}
+
+  void visibilityChanged() override {
+    if (isVisible())
+      startTimerHz(10);
+    else
+      stopTimer();
+  }
+
+  void paint(juce::Graphics &g) override {
+    using Colors = SolfeggioLookAndFeel::Colors;
+    auto bounds = getLocalBounds().toFloat();
+
+    g.setColour(Colors::background.withAlpha(0.92f));
+    g.fillRoundedRectangle(bounds, 8.0f);
+    g.setColour(Colors::surface);
+    g.drawRoundedRectangle(bounds.reduced(0.5f), 8.0f, 1.0f);
+
+    auto area = getLocalBounds().reduced(12, 8);
+    const auto &f = snapshot.window;
+    const int rowHeight = juce::jlimit(12, 20, area.getHeight() / (EngineProfiler::numStages + 3));
+
+    g.setFont(juce::Font(juce::FontOptions(11.0f).withStyle("Bold")));
+    g.setColour(Colors::gold);
+    g.drawText("DSP LOAD  (" + juce::String(f.callbacks) + " callbacks / window)",
+               area.removeFromTop(rowHeight), juce::Justification::centredLeft);
+
+    g.setFont(juce::Font(juce::FontOptions(10.0f)));
+    const float stageToLoad = f.callback.meanUs > 0.0f ? f.meanLoad / f.callback.meanUs : 0.0f;
+
+    for (int s = 0; s < EngineProfiler::numStages; ++s) {
+      const auto &t = f.stages[static_cast<size_t>(s)];
+      auto row = area.removeFromTop(rowHeight);
+
+      g.setColour(Colors::textSecondary);
+      g.drawText(EngineProfiler::getStageName(static_cast<EngineProfiler::Stage>(s)),
+                 row.removeFromLeft(90), juce::Justification::centredLeft);
+      g.drawText(juce::String(t.meanUs, 1) + " / " + juce::String(t.worstUs, 1) + " us",
+                 row.removeFromRight(110), juce::Justification::centredRight);
+
+      // Bar scale: full width = 10 % of the block's real-time budget
+      auto bar = row.reduced(4, 3).toFloat();
+      g.setColour(Colors::surface.withAlpha(0.5f));
+      g.fillRect(bar);
+      g.setColour(Colors::accent);
+      g.fillRect(bar.withWidth(bar.getWidth() * juce::jmin(1.0f, t.meanUs * stageToLoad * 10.0f)));
+    }
+
+    area.removeFromTop(4);
+    g.setColour(f.worstLoad > 0.5f ? Colors::danger : Colors::textPrimary);
+    g.drawText("Load " + juce::String(f.meanLoad * 100.0f, 1) + " % mean, "
+                   + juce::String(f.worstLoad * 100.0f, 1) + " % worst",
+               area.removeFromTop(rowHeight), juce::Justification::centredLeft);
+    g.setColour(Colors::textPrimary);
+    g.drawText("Callback jitter " + juce::String(f.meanJitterUs, 0) + " us mean, "
+                   + juce::String(f.worstJitterUs, 0) + " us worst",
+               area.removeFromTop(rowHeight), juce::Justification::centredLeft);
+  }
+
+private:
+  void timerCallback() override {
+    snapshot = processor.engine.getProfiler().getSnapshot();
+    repaint();
+  }
+
+  SolfeggioProcessor &processor;
+  EngineProfiler::Snapshot snapshot;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DiagnosticsPanel)
+};
@@ -7,7 +7,8 @@
 // ============================================================================
 // FrequencyControl (GUI/View layer)
 // Responsibility: Owns and manages the UI for a single Solfeggio oscillator
-// — gain knob, on/off toggle, name label, and description label.
+// — gain knob, on/off toggle, name label, description label, and a meter
+// of the output level at its frequency.
 // ============================================================================
 class FrequencyControl : public juce::Component {
 public:
@@ -49,6 +50,27 @@ public:
         descLabel.setBounds(0, knob.getBottom() + 18, area.getWidth(), 14);
     }
 
+    void paint(juce::Graphics& g) override {
+        using Colors = SolfeggioLookAndFeel::Colors;
+        auto bar = getMeterBounds().toFloat();
+        g.setColour(Colors::surface.withAlpha(0.6f));
+        g.fillRoundedRectangle(bar, 2.0f);
+
+        const float fill = juce::jmap(juce::jlimit(meterFloordB, 0.0f, meterdB), meterFloordB, 0.0f, 0.0f, 1.0f);
+        g.setColour(Colors::toggleOn);
+        g.fillRoundedRectangle(bar.removeFromBottom(bar.getHeight() * fill), 2.0f);
+    }
+
+    // Output level at this frequency (linear peak); repaints the meter only
+    // when the reading moves by a visible step
+    void setMeterLevel(float level) {
+        const float dB = juce::Decibels::gainToDecibels(level, meterFloordB);
+        if (std::abs(dB - meterdB) < 0.5f)
+            return;
+        meterdB = dB;
+        repaint(getMeterBounds());
+    }
+
     void setAlphaAndEnabled(float alpha, bool enabled) {
         knob.setAlpha(alpha);
         toggle.setAlpha(alpha);
@@ -57,9 +79,18 @@ public:
     }
 
 private:
+    juce::Rectangle<int> getMeterBounds() const {
+        return { knob.getX() - 8, knob.getY() + 4, 4, knob.getHeight() - 8 };
+    }
+
     SolfeggioProcessor& processor;
     int freqIndex;
 
+    // Carriers sit around -20 dBFS at full gain; 60 dB of range shows them
+    // against the music without the meter pinning
+    static constexpr float meterFloordB = -60.0f;
+    float meterdB = meterFloordB;
+
     juce::Slider       knob;
     juce::ToggleButton toggle;
     juce::Label        nameLabel, descLabel;
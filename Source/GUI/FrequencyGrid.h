@@ -31,6 +31,11 @@ public:
     }
   }
 
+  void updateMeters(const GoertzelBank &meters) {
+    for (int i = 0; i < controls.size(); ++i)
+      controls[i]->setMeterLevel(meters.getLevel(i));
+  }
+
 private:
   juce::OwnedArray<FrequencyControl> controls;
 };
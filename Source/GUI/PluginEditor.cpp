@@ -10,7 +10,9 @@ SolfeggioEditor::SolfeggioEditor(SolfeggioProcessor& p)
       processor(p),
       spectrumAnalyzer(p),
       autoModeBar(p),
-      frequencyGrid(p)
+      frequencyGrid(p),
+      diagnosticsPanel(p),
+      sendsPanel(p)
 {
     setLookAndFeel(&laf);
     setResizable(true, true);
@@ -39,6 +41,22 @@ SolfeggioEditor::SolfeggioEditor(SolfeggioProcessor& p)
     addAndMakeVisible(autoModeBar);
     addAndMakeVisible(frequencyGrid);
 
+    if (EngineProfiler::isEnabled()) {
+        diagnosticsButton.setClickingTogglesState(true);
+        diagnosticsButton.onClick = [this] {
+            diagnosticsPanel.setVisible(diagnosticsButton.getToggleState());
+        };
+        addAndMakeVisible(diagnosticsButton);
+        addChildComponent(diagnosticsPanel);
+    }
+
+    sendsButton.setClickingTogglesState(true);
+    sendsButton.onClick = [this] {
+        sendsPanel.setVisible(sendsButton.getToggleState());
+    };
+    addAndMakeVisible(sendsButton);
+    addChildComponent(sendsPanel);
+
     masterMixSlider.setSliderStyle(juce::Slider::LinearHorizontal);
     masterMixSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 60, 20);
     addAndMakeVisible(masterMixSlider);
@@ -59,10 +77,17 @@ SolfeggioEditor::~SolfeggioEditor() {
 }
 
 void SolfeggioEditor::timerCallback() {
-    bool autoOn = processor.apvts.getRawParameterValue(
-        Solfeggio::Params::autoMode.getParamID())->load() > 0.5f;
-    autoModeBar.updateVisibility();
-    frequencyGrid.updateVisuals(autoOn);
+    // Meters repaint themselves only when a reading moves visibly
+    frequencyGrid.updateMeters(processor.engine.getToneMeters());
+
+    const auto version = processor.viewModel.getVersion();
+    if (version == appliedViewVersion)
+        return;
+    appliedViewVersion = version;
+
+    const auto state = processor.viewModel.getState();
+    autoModeBar.update(state);
+    frequencyGrid.updateVisuals(state.autoMode);
 }
 
 void SolfeggioEditor::paint(juce::Graphics& g) {
@@ -79,11 +104,18 @@ void SolfeggioEditor::paint(juce::Graphics& g) {
 void SolfeggioEditor::resized() {
     auto area = getLocalBounds().reduced(12);
 
-    titleLabel.setBounds(area.removeFromTop(32));
+    auto titleArea = area.removeFromTop(32);
+    diagnosticsButton.setBounds(titleArea.removeFromRight(48).reduced(2, 4));
+    sendsButton.setBounds(titleArea.removeFromLeft(64).reduced(2, 4));
+    titleLabel.setBounds(titleArea.withTrimmedRight(16));
     area.removeFromTop(4);
 
     const int specHeight = juce::jlimit(120, 250, area.getHeight() / 4);
     spectrumAnalyzer.setBounds(area.removeFromTop(specHeight).reduced(4, 2));
+    diagnosticsPanel.setBounds(spectrumAnalyzer.getBounds().removeFromRight(
+        juce::jmin(420, spectrumAnalyzer.getWidth())));
+    sendsPanel.setBounds(spectrumAnalyzer.getBounds().removeFromLeft(
+        juce::jmin(420, spectrumAnalyzer.getWidth())));
     area.removeFromTop(12);
 
     autoModeBar.setBounds(area.removeFromTop(35));
@@ -5,6 +5,8 @@
 #include "SpectrumAnalyzer.h"
 #include "AutoModeBar.h"
 #include "FrequencyGrid.h"
+#include "DiagnosticsPanel.h"
+#include "ChannelSendsPanel.h"
 
 // ============================================================================
 // SolfeggioEditor  (GUI / View layer)
@@ -25,12 +27,23 @@ private:
     SolfeggioProcessor& processor;
     SolfeggioLookAndFeel laf;
 
+    // View-model version last applied to the components (0 = never)
+    juce::uint32 appliedViewVersion = 0;
+
     // Top-level visual components (ordered top → bottom in the layout)
     juce::Label       titleLabel;
     SpectrumAnalyzer  spectrumAnalyzer;
     AutoModeBar       autoModeBar;
     FrequencyGrid     frequencyGrid;
 
+    // Per-stage DSP timings over the spectrum; only in profiling builds
+    juce::TextButton  diagnosticsButton { "DSP" };
+    DiagnosticsPanel  diagnosticsPanel;
+
+    // Per-channel Solfeggio sends over the spectrum
+    juce::TextButton  sendsButton { "SENDS" };
+    ChannelSendsPanel sendsPanel;
+
     juce::Slider masterMixSlider;
     juce::Label  masterMixLabel;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> masterMixAttachment;
@@ -9,15 +9,192 @@
 class SpectrumAnalyzer : public juce::Component, private juce::Timer {
 public:
   explicit SpectrumAnalyzer(SolfeggioProcessor &proc) : processor(proc) {
-    startTimerHz(30); // 30fps
     scopeData.fill(0.0f);
+    processor.engine.getSpectrum().startAnalysis();
+    startTimerHz(30); // 30fps
+  }
+
+  ~SpectrumAnalyzer() override {
+    stopTimer();
+    processor.engine.getSpectrum().stopAnalysis();
   }
 
   void paint(juce::Graphics &g) override {
+    // Background, grid and markers only change with size or display scale
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (staticLayer.isNull() || staticLayerScale != scale)
+      renderStaticLayer(scale);
+    g.drawImage(staticLayer, getLocalBounds().toFloat());
+
+    // Spectrum curve: the paths keep their storage between frames
+    auto bounds = getLocalBounds().toFloat();
+    const float w = bounds.getWidth();
+    const float padding = 10.0f;
+    const float drawH = bounds.getHeight() - padding * 2;
+    const float baseline = bounds.getBottom() - padding;
+
+    spectrumPath.clear();
+    fillPath.clear();
+    for (int i = 0; i < scopeSize; ++i) {
+      float x = bounds.getX() + (static_cast<float>(i) / static_cast<float>(scopeSize)) * w;
+      float y = baseline - scopeData[static_cast<size_t>(i)] * drawH;
+      y = juce::jlimit(bounds.getY() + padding, baseline, y);
+
+      if (i == 0) {
+        spectrumPath.startNewSubPath(x, y);
+        fillPath.startNewSubPath(x, y);
+      } else {
+        spectrumPath.lineTo(x, y);
+        fillPath.lineTo(x, y);
+      }
+    }
+
+    // Filled area under curve
+    fillPath.lineTo(bounds.getRight(), baseline);
+    fillPath.lineTo(bounds.getX(), baseline);
+    fillPath.closeSubPath();
+    g.setGradientFill(fillGradient);
+    g.fillPath(fillPath);
+
+    // Spectrum line stroke
+    g.setGradientFill(lineGradient);
+    g.strokePath(spectrumPath, juce::PathStrokeType(1.5f));
+  }
+
+  void resized() override {
+    staticLayer = {};
+
+    auto bounds = getLocalBounds().toFloat();
+    fillGradient = juce::ColourGradient(
+        SolfeggioLookAndFeel::Colors::accent.withAlpha(0.3f), 0, bounds.getY(),
+        SolfeggioLookAndFeel::Colors::accent.withAlpha(0.02f), 0, bounds.getBottom(), false);
+    lineGradient = juce::ColourGradient(
+        SolfeggioLookAndFeel::Colors::accent, 0, bounds.getY(),
+        SolfeggioLookAndFeel::Colors::gold, 0, bounds.getBottom(), false);
+  }
+
+  // Right-click: analysis resolution, window, overlap and averaging
+  void mouseDown(const juce::MouseEvent &e) override {
+    if (!e.mods.isPopupMenu())
+      return;
+
+    auto &spectrum = processor.engine.getSpectrum();
+    const auto current = spectrum.getSettings();
+    auto apply = [this](auto change) {
+      return [this, change] {
+        auto &analysis = processor.engine.getSpectrum();
+        auto s = analysis.getSettings();
+        change(s);
+        analysis.setSettings(s);
+      };
+    };
+
+    juce::PopupMenu sizeMenu;
+    for (int order = SpectrumAnalysis::minFftOrder; order <= SpectrumAnalysis::maxFftOrder; ++order)
+      sizeMenu.addItem(juce::String(1 << order), true, current.fftOrder == order,
+                       apply([order](auto &s) { s.fftOrder = order; }));
+
+    juce::PopupMenu windowMenu;
+    windowMenu.addItem("Hann", true, current.window == SpectrumAnalysis::Window::hann,
+                       apply([](auto &s) { s.window = SpectrumAnalysis::Window::hann; }));
+    windowMenu.addItem("Blackman-Harris", true, current.window == SpectrumAnalysis::Window::blackmanHarris,
+                       apply([](auto &s) { s.window = SpectrumAnalysis::Window::blackmanHarris; }));
+
+    juce::PopupMenu overlapMenu;
+    for (float overlap : {0.5f, 0.75f, 0.875f})
+      overlapMenu.addItem(juce::String(overlap * 100.0f, overlap == 0.875f ? 1 : 0) + " %", true,
+                          juce::approximatelyEqual(current.overlap, overlap),
+                          apply([overlap](auto &s) { s.overlap = overlap; }));
+
+    juce::PopupMenu averagingMenu;
+    for (float ms : {0.0f, 50.0f, 100.0f, 250.0f, 500.0f})
+      averagingMenu.addItem(ms > 0.0f ? juce::String(static_cast<int>(ms)) + " ms" : juce::String("Off"), true,
+                            juce::approximatelyEqual(current.averagingMs, ms),
+                            apply([ms](auto &s) { s.averagingMs = ms; }));
+
+    juce::PopupMenu menu;
+    menu.addSubMenu("FFT size", sizeMenu);
+    menu.addSubMenu("Window", windowMenu);
+    menu.addSubMenu("Overlap", overlapMenu);
+    menu.addSubMenu("Averaging", averagingMenu);
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this).withMousePosition());
+  }
+
+private:
+  void timerCallback() override {
+    // Nothing moves between frames, so only a new frame is repainted
+    auto &spectrum = processor.engine.getSpectrum();
+    if (spectrum.fetchLatestFrame()) {
+      const auto &frame = spectrum.getLatestFrame();
+      if (frame.numBins < 2)
+        return;
+      if (frame.sampleRate != binMapSampleRate || frame.numBins != binMapNumBins)
+        rebuildBinMap(frame.sampleRate, frame.numBins);
+
+      // Convert FFT data to scope display
+      auto mindB = -80.0f;
+      auto maxdB = 0.0f;
+
+      for (int i = 0; i < scopeSize; ++i) {
+        const auto &map = binMap[static_cast<size_t>(i)];
+        const float *mags = frame.magnitudes.data() + map.bin;
+
+        // Peak of every bin under this point; below one bin per point,
+        // interpolate between the two nearest bins instead
+        float magnitude = 0.0f;
+        if (map.count > 0)
+          magnitude = *std::max_element(mags, mags + map.count);
+        else
+          magnitude = mags[0] + (mags[1] - mags[0]) * map.frac;
+
+        // Magnitudes are already averaged by the analysis (see its settings)
+        auto level = juce::Decibels::gainToDecibels(magnitude, mindB);
+        scopeData[static_cast<size_t>(i)] = juce::jmap(level, mindB, maxdB, 0.0f, 1.0f);
+      }
+
+      repaint();
+    }
+  }
+
+  // Scope point i spans [f(i), f(i+1)) on the log axis. Points wide enough
+  // to hold bin centres take the peak of those bins; narrower points (the
+  // low end) interpolate at their centre frequency.
+  void rebuildBinMap(double sampleRate, int numBins) {
+    binMapSampleRate = sampleRate;
+    binMapNumBins = numBins;
+    const double binWidth = sampleRate / (2.0 * numBins);
+
+    for (int i = 0; i < scopeSize; ++i) {
+      const double lo = mapScopeIndexToFreq(i) / binWidth;
+      const double hi = mapScopeIndexToFreq(i + 1) / binWidth;
+      auto &map = binMap[static_cast<size_t>(i)];
+
+      const int first = juce::jlimit(0, numBins - 1, static_cast<int>(std::ceil(lo)));
+      const int last  = juce::jlimit(0, numBins - 1, static_cast<int>(std::floor(hi)));
+      if (last >= first && hi - lo >= 1.0) {
+        map = { first, last - first + 1, 0.0f };
+      } else {
+        const double centre = juce::jlimit(0.0, numBins - 2.0, 0.5 * (lo + hi));
+        const int bin = static_cast<int>(centre);
+        map = { bin, 0, static_cast<float>(centre - bin) };
+      }
+    }
+  }
+
+  // Draws everything except the curve into staticLayer at the display's
+  // physical resolution, so the cached image stays sharp on HiDPI screens
+  void renderStaticLayer(float scale) {
     auto bounds = getLocalBounds().toFloat();
     auto w = bounds.getWidth();
     auto h = bounds.getHeight();
 
+    staticLayerScale = scale;
+    staticLayer = juce::Image(juce::Image::ARGB,
+                              juce::jmax(1, juce::roundToInt(w * scale)),
+                              juce::jmax(1, juce::roundToInt(h * scale)), true);
+    juce::Graphics g(staticLayer);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     // Background with gradient
     auto bgGradient = juce::ColourGradient(
         SolfeggioLookAndFeel::Colors::background, 0, 0,
@@ -39,6 +216,7 @@ public:
     }
 
     // Draw Solfeggio frequency markers
+    g.setFont(juce::Font(juce::FontOptions(9.0f)));
     for (int i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i) {
       float freq = Solfeggio::Frequencies[static_cast<size_t>(i)];
       float x = freqToX(freq, w) + bounds.getX();
@@ -50,80 +228,10 @@ public:
 
       // Frequency label
       g.setColour(SolfeggioLookAndFeel::Colors::gold.withAlpha(0.7f));
-      g.setFont(juce::Font(juce::FontOptions(9.0f)));
       g.drawText(juce::String(static_cast<int>(freq)), static_cast<int>(x - 15),
                  static_cast<int>(bounds.getY() + 2), 30, 12,
                  juce::Justification::centred);
     }
-
-    // Draw spectrum path
-    juce::Path spectrumPath;
-    bool pathStarted = false;
-    float padding = 10.0f;
-    float drawH = h - padding * 2;
-
-    for (int i = 0; i < scopeSize; ++i) {
-      float x = bounds.getX() + (static_cast<float>(i) / static_cast<float>(scopeSize)) * w;
-      float y = bounds.getBottom() - padding - scopeData[static_cast<size_t>(i)] * drawH;
-      y = juce::jlimit(bounds.getY() + padding, bounds.getBottom() - padding, y);
-
-      if (!pathStarted) {
-        spectrumPath.startNewSubPath(x, y);
-        pathStarted = true;
-      } else {
-        spectrumPath.lineTo(x, y);
-      }
-    }
-
-    // Filled area under curve
-    if (pathStarted) {
-      juce::Path fillPath(spectrumPath);
-      fillPath.lineTo(bounds.getRight(), bounds.getBottom() - padding);
-      fillPath.lineTo(bounds.getX(), bounds.getBottom() - padding);
-      fillPath.closeSubPath();
-
-      auto fillGradient = juce::ColourGradient(
-          SolfeggioLookAndFeel::Colors::accent.withAlpha(0.3f), 0, bounds.getY(),
-          SolfeggioLookAndFeel::Colors::accent.withAlpha(0.02f), 0, bounds.getBottom(), false);
-      g.setGradientFill(fillGradient);
-      g.fillPath(fillPath);
-
-      // Spectrum line stroke
-      auto lineGradient = juce::ColourGradient(
-          SolfeggioLookAndFeel::Colors::accent, 0, bounds.getY(),
-          SolfeggioLookAndFeel::Colors::gold, 0, bounds.getBottom(), false);
-      g.setGradientFill(lineGradient);
-      g.strokePath(spectrumPath, juce::PathStrokeType(1.5f));
-    }
-  }
-
-  void resized() override {}
-
-private:
-  void timerCallback() override {
-    if (processor.engine.isFFTDataReady()) {
-      // Convert FFT data to scope display
-      auto mindB = -80.0f;
-      auto maxdB = 0.0f;
-
-      for (int i = 0; i < scopeSize; ++i) {
-        // Map scope index to FFT bin (logarithmic)
-        auto freq = mapScopeIndexToFreq(i);
-        auto fftBin = static_cast<int>(
-            freq / (44100.0f / static_cast<float>(SolfeggioEngine::fftSize)));
-        fftBin = juce::jlimit(0, SolfeggioEngine::fftSize / 2 - 1, fftBin);
-
-        auto level = juce::Decibels::gainToDecibels(
-            processor.engine.getFFTData()[static_cast<size_t>(fftBin)], mindB);
-
-        auto normalised = juce::jmap(level, mindB, maxdB, 0.0f, 1.0f);
-
-        // Smooth the display
-        scopeData[static_cast<size_t>(i)] =
-            scopeData[static_cast<size_t>(i)] * 0.7f + normalised * 0.3f;
-      }
-    }
-    repaint();
   }
 
   float freqToX(float freq, float width) const {
@@ -145,5 +253,23 @@ private:
   static constexpr int scopeSize = 512;
   std::array<float, scopeSize> scopeData{};
 
+  // FFT bins under each scope point; rebuilt when the sample rate or FFT
+  // size changes
+  struct ScopeBins {
+    int bin = 0;      // first bin
+    int count = 0;    // bins to take the peak of; 0 = interpolate
+    float frac = 0.0f; // position between bin and bin + 1 when count == 0
+  };
+  std::array<ScopeBins, scopeSize> binMap{};
+  double binMapSampleRate = 0.0;
+  int binMapNumBins = 0;
+
+  // Cached static layer (rebuilt after resized() or a display-scale change)
+  // and per-frame drawing state reused across paints
+  juce::Image staticLayer;
+  float staticLayerScale = 0.0f;
+  juce::Path spectrumPath, fillPath;
+  juce::ColourGradient fillGradient, lineGradient;
+
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzer)
 };
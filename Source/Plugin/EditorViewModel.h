@@ -0,0 +1,56 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include "Constants.h"
+#include "SmartAutoEngine.h"
+
+// ============================================================================
+// EditorViewModel  (Plugin / Controller layer)
+// Responsibility: The few pieces of processor state the editor lays itself
+// out from — auto mode and the detected music profile — published through
+// atomics with a version counter that moves only when a value changes.
+//
+// Writers are the audio thread (profile, after each block) and whichever
+// thread changes the autoMode parameter (via the APVTS listener), so the
+// editor stays current even when the host stops calling processBlock. Both
+// writes are lock-free and skip the store when nothing changed. The editor
+// polls getVersion() on its timer and touches components only when it
+// differs from the version it last applied; an idle editor costs one atomic
+// load per tick.
+// ============================================================================
+class EditorViewModel : public juce::AudioProcessorValueTreeState::Listener {
+public:
+    struct State {
+        bool autoMode = true;
+        SmartAutoEngine::MusicProfile profile = SmartAutoEngine::MusicProfile::Quiet;
+    };
+
+    explicit EditorViewModel(bool initialAutoMode) : autoMode(initialAutoMode) {}
+
+    // Audio thread
+    void setProfile(SmartAutoEngine::MusicProfile newProfile) noexcept {
+        if (profile.exchange(newProfile, std::memory_order_relaxed) != newProfile)
+            version.fetch_add(1, std::memory_order_release);
+    }
+
+    // Any thread — APVTS calls this from wherever the parameter was set
+    void parameterChanged(const juce::String&, float newValue) override {
+        const bool on = newValue > 0.5f;
+        if (autoMode.exchange(on, std::memory_order_relaxed) != on)
+            version.fetch_add(1, std::memory_order_release);
+    }
+
+    // Message thread
+    juce::uint32 getVersion() const noexcept { return version.load(std::memory_order_acquire); }
+
+    State getState() const noexcept {
+        return { autoMode.load(std::memory_order_relaxed), profile.load(std::memory_order_relaxed) };
+    }
+
+private:
+    std::atomic<juce::uint32> version { 1 };
+    std::atomic<bool> autoMode;
+    std::atomic<SmartAutoEngine::MusicProfile> profile { SmartAutoEngine::MusicProfile::Quiet };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EditorViewModel)
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "Constants.h"
+
+// ============================================================================
+// ParameterHandles  (Plugin / Controller layer)
+// Responsibility: Resolves every APVTS parameter to its raw atomic exactly
+// once, at construction. The audio thread reads only from this table, so it
+// never builds juce::String IDs or does hash lookups per block; the
+// SolfeggioRealtimeCheck test fails if processBlock allocates at all.
+// The pointers are packed together and cache-line aligned: one processBlock
+// touches four consecutive lines instead of 30 scattered map nodes.
+// ============================================================================
+struct alignas(64) ParameterHandles {
+    using Handle = std::atomic<float>*;
+
+    explicit ParameterHandles(juce::AudioProcessorValueTreeState& apvts) {
+        auto resolve = [&apvts](const juce::String& id) {
+            auto* raw = apvts.getRawParameterValue(id);
+            jassert(raw != nullptr);
+            return raw;
+        };
+
+        for (size_t i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i) {
+            gain[i] = resolve(Solfeggio::Params::getGainID(Solfeggio::Frequencies[i]));
+            on[i]   = resolve(Solfeggio::Params::getOnID  (Solfeggio::Frequencies[i]));
+        }
+
+        autoMode      = resolve(Solfeggio::Params::autoMode.getParamID());
+        cycleTime     = resolve(Solfeggio::Params::cycleTime.getParamID());
+        autoIntensity = resolve(Solfeggio::Params::autoIntensity.getParamID());
+        masterMix     = resolve(Solfeggio::Params::masterMix.getParamID());
+        scAttack      = resolve(Solfeggio::Params::scAttack.getParamID());
+        scRelease     = resolve(Solfeggio::Params::scRelease.getParamID());
+        scDryWet      = resolve(Solfeggio::Params::scDryWet.getParamID());
+        scLink        = resolve(Solfeggio::Params::scLink.getParamID());
+        scLookahead   = resolve(Solfeggio::Params::scLookahead.getParamID());
+        scDetector    = resolve(Solfeggio::Params::scDetector.getParamID());
+    }
+
+    static float load(Handle h) noexcept { return h->load(std::memory_order_relaxed); }
+
+    std::array<Handle, Solfeggio::NUM_FREQUENCIES> gain {};
+    std::array<Handle, Solfeggio::NUM_FREQUENCIES> on   {};
+
+    Handle autoMode      = nullptr;
+    Handle cycleTime     = nullptr;
+    Handle autoIntensity = nullptr;
+    Handle masterMix     = nullptr;
+    Handle scAttack      = nullptr;
+    Handle scRelease     = nullptr;
+    Handle scDryWet      = nullptr;
+    Handle scLink        = nullptr;
+    Handle scLookahead   = nullptr;
+    Handle scDetector    = nullptr;
+};
@@ -1,47 +1,105 @@
 #include "SolfeggioProcessor.h"
 #include "PluginEditor.h"
 
+namespace {
+
+    // The automatable controls as the parameters hold them for this block;
+    // the engine glides to them from the previous block's values
+    SolfeggioEngine::Controls readControls(const ParameterHandles& handles) noexcept {
+        SolfeggioEngine::Controls controls;
+        for (size_t i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i) {
+            const bool on = ParameterHandles::load(handles.on[i]) > 0.5f;
+            controls.manualGains[i] = on ? ParameterHandles::load(handles.gain[i]) : 0.0f;
+        }
+        controls.cycleTime     = ParameterHandles::load(handles.cycleTime);
+        controls.autoIntensity = ParameterHandles::load(handles.autoIntensity) / 100.0f;
+        controls.masterMix     = ParameterHandles::load(handles.masterMix) / 100.0f;
+        return controls;
+    }
+
+} // namespace
+
 SolfeggioProcessor::SolfeggioProcessor()
     : AudioProcessor(BusesProperties()
         .withInput ("Input",  juce::AudioChannelSet::stereo(), true)
         .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
       apvts(*this, nullptr, "Parameters", createParameterLayout())
-{}
+{
+    apvts.addParameterListener(Solfeggio::Params::autoMode.getParamID(), &viewModel);
+}
+
+SolfeggioProcessor::~SolfeggioProcessor() {
+    apvts.removeParameterListener(Solfeggio::Params::autoMode.getParamID(), &viewModel);
+}
 
 void SolfeggioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
-    engine.prepare(sampleRate, samplesPerBlock);
+    applyLookahead(sampleRate);
+    engine.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    applyChannelSends();
+}
+
+// The look-ahead delay and the latency reported for it change together,
+// here and nowhere else
+void SolfeggioProcessor::applyLookahead(double sampleRate) {
+    const auto& steps = SidechainCompressor::lookaheadStepsMs;
+    const int step = juce::jlimit(0, static_cast<int>(steps.size()) - 1,
+                                  juce::roundToInt(ParameterHandles::load(paramHandles.scLookahead)));
+    const float lookaheadMs = steps[static_cast<size_t>(step)];
+
+    engine.setLookaheadMs(lookaheadMs);
+    setLatencySamples(SidechainCompressor::lookaheadSamples(lookaheadMs, sampleRate));
+}
+
+float SolfeggioProcessor::getChannelSend(juce::AudioChannelSet::ChannelType type) const {
+    const bool isLfe = type == juce::AudioChannelSet::LFE || type == juce::AudioChannelSet::LFE2;
+    const auto sends = apvts.state.getChildWithName(Solfeggio::State::channelSends);
+    return sends.getProperty(juce::AudioChannelSet::getAbbreviatedChannelTypeName(type), isLfe ? 0.0f : 1.0f);
+}
+
+void SolfeggioProcessor::setChannelSend(juce::AudioChannelSet::ChannelType type, float send) {
+    auto sends = apvts.state.getOrCreateChildWithName(Solfeggio::State::channelSends, nullptr);
+    sends.setProperty(juce::AudioChannelSet::getAbbreviatedChannelTypeName(type),
+                      juce::jlimit(0.0f, 1.0f, send), nullptr);
+    applyChannelSends();
+}
+
+void SolfeggioProcessor::applyChannelSends() {
+    const auto layout = getChannelLayoutOfBus(false, 0);
+    for (int ch = 0; ch < layout.size(); ++ch)
+        engine.setChannelSend(ch, getChannelSend(layout.getTypeOfChannel(ch)));
 }
 
 void SolfeggioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) {
+    processSamples(buffer);
+}
+
+void SolfeggioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&) {
+    processSamples(buffer);
+}
+
+template <typename SampleType>
+void SolfeggioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer) {
     juce::ScopedNoDenormals noDenormals;
 
-    engine.setSidechainParams(
-        apvts.getRawParameterValue(Solfeggio::Params::scAttack.getParamID())->load(),
-        apvts.getRawParameterValue(Solfeggio::Params::scRelease.getParamID())->load(),
-        apvts.getRawParameterValue(Solfeggio::Params::scDryWet.getParamID())->load()
-    );
+    engine.setSidechainParams(ParameterHandles::load(paramHandles.scAttack),
+                              ParameterHandles::load(paramHandles.scRelease),
+                              ParameterHandles::load(paramHandles.scDryWet),
+                              static_cast<SidechainCompressor::LinkMode>(
+                                  juce::roundToInt(ParameterHandles::load(paramHandles.scLink))),
+                              static_cast<SidechainCompressor::DetectorMode>(
+                                  juce::roundToInt(ParameterHandles::load(paramHandles.scDetector))));
 
-    std::array<float, Solfeggio::NUM_FREQUENCIES> manualGains;
-    for (int i = 0; i < Solfeggio::NUM_FREQUENCIES; ++i) {
-        float freq = Solfeggio::Frequencies[static_cast<size_t>(i)];
-        float gain = apvts.getRawParameterValue(Solfeggio::Params::getGainID(freq))->load();
-        bool  on   = apvts.getRawParameterValue(Solfeggio::Params::getOnID(freq))->load() > 0.5f;
-        manualGains[static_cast<size_t>(i)] = on ? gain : 0.0f;
-    }
+    engine.process(buffer, ParameterHandles::load(paramHandles.autoMode) > 0.5f, readControls(paramHandles));
 
-    engine.process(
-        buffer,
-        apvts.getRawParameterValue(Solfeggio::Params::autoMode.getParamID())->load() > 0.5f,
-        apvts.getRawParameterValue(Solfeggio::Params::cycleTime.getParamID())->load(),
-        apvts.getRawParameterValue(Solfeggio::Params::autoIntensity.getParamID())->load() / 100.0f,
-        manualGains,
-        apvts.getRawParameterValue(Solfeggio::Params::masterMix.getParamID())->load() / 100.0f
-    );
+    viewModel.setProfile(engine.getAutoEngine().getCurrentProfile());
 }
 
+// Any discrete or surround layout, as long as input and output match
 bool SolfeggioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
-    return layouts.getMainOutputChannelSet() == juce::AudioChannelSet::stereo()
-        && layouts.getMainInputChannelSet()  == juce::AudioChannelSet::stereo();
+    const auto& output = layouts.getMainOutputChannelSet();
+    return ! output.isDisabled()
+        && output.size() <= SolfeggioEngine::maxChannels
+        && layouts.getMainInputChannelSet() == output;
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SolfeggioProcessor::createParameterLayout() {
@@ -70,6 +128,20 @@ juce::AudioProcessorValueTreeState::ParameterLayout SolfeggioProcessor::createPa
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         Solfeggio::Params::scDryWet,       "SC Dry/Wet",
         juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f), 0.5f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        Solfeggio::Params::scLink,         "SC Link",
+        juce::StringArray { "Unlinked", "Linked (Max)", "Linked (Mean)" }, 1));
+
+    // Not automatable: it sets the plugin's latency (see applyLookahead)
+    juce::StringArray lookaheadSteps;
+    for (float ms : SidechainCompressor::lookaheadStepsMs)
+        lookaheadSteps.add(ms > 0.0f ? juce::String(ms, 0) + " ms" : "Off");
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        Solfeggio::Params::scLookahead,    "SC Look-ahead", lookaheadSteps, 0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        Solfeggio::Params::scDetector,     "SC Detector",
+        juce::StringArray { "Peak", "RMS" }, 0));
     params.push_back(std::make_unique<juce::AudioParameterBool>(
         Solfeggio::Params::autoMode,       "Auto Mode", true));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
@@ -83,15 +155,22 @@ juce::AudioProcessorValueTreeState::ParameterLayout SolfeggioProcessor::createPa
 }
 
 void SolfeggioProcessor::getStateInformation(juce::MemoryBlock& destData) {
-    auto state = apvts.copyState();
-    if (auto xml = state.createXml())
-        copyXmlToBinary(*xml, destData);
+    stateCodec.write(destData);
 }
 
 void SolfeggioProcessor::setStateInformation(const void* data, int sizeInBytes) {
+    if (StateCodec::isBinaryState(data, sizeInBytes)) {
+        if (stateCodec.read(data, sizeInBytes))
+            applyChannelSends();
+        return;
+    }
+
+    // Sessions saved before the binary format hold the APVTS tree as XML
     if (auto xml = getXmlFromBinary(data, sizeInBytes))
-        if (xml->hasTagName(apvts.state.getType()))
+        if (xml->hasTagName(apvts.state.getType())) {
             apvts.replaceState(juce::ValueTree::fromXml(*xml));
+            applyChannelSends();
+        }
 }
 
 juce::AudioProcessorEditor* SolfeggioProcessor::createEditor() {
@@ -2,6 +2,9 @@
 #include <JuceHeader.h>
 #include "Constants.h"
 #include "SolfeggioEngine.h"
+#include "EditorViewModel.h"
+#include "ParameterHandles.h"
+#include "StateCodec.h"
 
 // ============================================================================
 // SolfeggioProcessor  (Plugin / Controller layer)
@@ -11,12 +14,12 @@
 class SolfeggioProcessor : public juce::AudioProcessor {
 public:
     SolfeggioProcessor();
-    ~SolfeggioProcessor() override = default;
+    ~SolfeggioProcessor() override;
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-    // Explicitly pull in double-buffer overload to satisfy JUCE 8's hidden-virtual check
-    using juce::AudioProcessor::processBlock;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
     void releaseResources() override { engine.reset(); }
 
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
@@ -37,10 +40,46 @@ public:
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
 
+    // Solfeggio send for every channel of this type in the current layout
+    // (0..1). Saved with the plugin state; unset types default to 1, and
+    // to 0 for LFE. Message thread.
+    void setChannelSend(juce::AudioChannelSet::ChannelType type, float send);
+    float getChannelSend(juce::AudioChannelSet::ChannelType type) const;
+
     juce::AudioProcessorValueTreeState apvts;
     SolfeggioEngine engine;
 
+    // Auto mode and profile for the editor, versioned so it redraws on change only
+    EditorViewModel viewModel {
+        apvts.getRawParameterValue(Solfeggio::Params::autoMode.getParamID())->load() > 0.5f };
+
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+
+    // Pushes the saved / default sends for the current layout to the engine
+    void applyChannelSends();
+
+    // Shared body of both processBlock overloads
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    // Resolved after apvts (declaration order matters); audio-thread reads only
+    const ParameterHandles paramHandles { apvts };
+
+    // Binary save / load of the parameters and channel sends
+    StateCodec stateCodec { apvts };
+
+    // Sets the engine's look-ahead and the latency reported for it from the
+    // scLookahead step; prepareToPlay and the attachment below both use it
+    void applyLookahead(double sampleRate);
+
+    // A new look-ahead step applies without waiting for the host to
+    // re-prepare (Standalone and many hosts never do): the engine switches
+    // delay at its next block and the latency is updated here. The
+    // attachment calls back on the message thread.
+    juce::ParameterAttachment lookaheadAttachment {
+        *apvts.getParameter(Solfeggio::Params::scLookahead.getParamID()),
+        [this](float) { applyLookahead(getSampleRate()); } };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SolfeggioProcessor)
 };
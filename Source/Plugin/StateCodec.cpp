@@ -0,0 +1,239 @@
+#include "StateCodec.h"
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+    constexpr char magic[4] = { 'S', 'L', 'F', 'S' };
+    constexpr int sendValueBytes = 1 + 4;   // length byte + float, plus the name
+    constexpr int checksumOffset = 10;      // after magic, version and the two counts
+
+    // The on-disk key of every parameter is its index here. Append only.
+    std::array<juce::String, StateCodec::numParameters> parameterOrder() {
+        std::array<juce::String, StateCodec::numParameters> ids;
+        size_t n = 0;
+        for (float freq : Solfeggio::Frequencies)
+            ids[n++] = Solfeggio::Params::getGainID(freq);
+        for (float freq : Solfeggio::Frequencies)
+            ids[n++] = Solfeggio::Params::getOnID(freq);
+
+        for (const auto* id : { &Solfeggio::Params::masterMix, &Solfeggio::Params::scAttack,
+                                &Solfeggio::Params::scRelease, &Solfeggio::Params::scDryWet,
+                                &Solfeggio::Params::scLink,    &Solfeggio::Params::autoMode,
+                                &Solfeggio::Params::cycleTime, &Solfeggio::Params::autoIntensity,
+                                &Solfeggio::Params::scLookahead, &Solfeggio::Params::scDetector })
+            ids[n++] = id->getParamID();
+
+        jassert(n == ids.size());
+        return ids;
+    }
+
+    // Little-endian cursor over a fixed-size block
+    class Writer {
+    public:
+        explicit Writer(char* dest) : pos(dest) {}
+
+        void bytes(const void* src, size_t size) { std::memcpy(pos, src, size); pos += size; }
+        void u8 (juce::uint8 v)  { bytes(&v, 1); }
+        void u16(juce::uint16 v) { v = juce::ByteOrder::swapIfBigEndian(v); bytes(&v, 2); }
+        void u32(juce::uint32 v) { v = juce::ByteOrder::swapIfBigEndian(v); bytes(&v, 4); }
+        void f32(float v)        { u32(std::bit_cast<juce::uint32>(v)); }
+
+    private:
+        char* pos;
+    };
+
+    // Bounds-checked counterpart: every read fails once the blob runs out
+    class Reader {
+    public:
+        Reader(const void* src, int size) : pos(static_cast<const char*>(src)), end(pos + size) {}
+
+        bool skip(size_t size) {
+            if (static_cast<size_t>(end - pos) < size)
+                return false;
+            pos += size;
+            return true;
+        }
+
+        const char* bytes(size_t size) {
+            const char* start = pos;
+            return skip(size) ? start : nullptr;
+        }
+
+        bool u8(juce::uint8& v) {
+            if (auto* p = bytes(1)) { v = static_cast<juce::uint8>(*p); return true; }
+            return false;
+        }
+
+        bool u16(juce::uint16& v) {
+            if (auto* p = bytes(2)) { v = juce::ByteOrder::littleEndianShort(p); return true; }
+            return false;
+        }
+
+        bool u32(juce::uint32& v) {
+            if (auto* p = bytes(4)) { v = juce::ByteOrder::littleEndianInt(p); return true; }
+            return false;
+        }
+
+        bool f32(float& v) {
+            juce::uint32 bits = 0;
+            if (! u32(bits))
+                return false;
+            v = std::bit_cast<float>(bits);
+            return true;
+        }
+
+        bool atEnd() const noexcept { return pos == end; }
+
+    private:
+        const char* pos;
+        const char* end;
+    };
+
+    struct Header {
+        juce::uint16 version = 0, numParameters = 0, numSends = 0, checksum = 0;
+        juce::uint32 payloadBytes = 0;
+    };
+
+    bool readHeader(Reader& in, Header& h) {
+        return in.skip(sizeof(magic))
+            && in.u16(h.version) && in.u16(h.numParameters) && in.u16(h.numSends)
+            && in.u16(h.checksum) && in.u32(h.payloadBytes);
+    }
+
+    // Catches every single-bit error and most bursts; the blob is small
+    // enough that this costs nothing next to setting the parameters
+    juce::uint16 fletcher16(const void* data, size_t size) noexcept {
+        const auto* bytes = static_cast<const juce::uint8*>(data);
+        juce::uint32 a = 0, b = 0;
+        for (size_t i = 0; i < size; ++i) {
+            a = (a + bytes[i]) % 255;
+            b = (b + a) % 255;
+        }
+        return static_cast<juce::uint16>((b << 8) | a);
+    }
+
+    // Version 1 blobs were written before the checksum and carry 0
+    constexpr juce::uint16 firstChecksummedVersion = 2;
+
+} // namespace
+
+StateCodec::StateCodec(juce::AudioProcessorValueTreeState& state) : apvts(state) {
+    const auto ids = parameterOrder();
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        parameters[i] = apvts.getParameter(ids[i]);
+        jassert(parameters[i] != nullptr);
+    }
+}
+
+bool StateCodec::isBinaryState(const void* data, int sizeInBytes) noexcept {
+    return data != nullptr && sizeInBytes >= headerBytes && std::memcmp(data, magic, sizeof(magic)) == 0;
+}
+
+void StateCodec::write(juce::MemoryBlock& destData) const {
+    const auto sends = apvts.state.getChildWithName(Solfeggio::State::channelSends);
+
+    // Abbreviations are a few characters; anything that would not fit the
+    // length byte is not a channel type and is dropped
+    auto nameBytes = [&sends](int i) {
+        return sends.getPropertyName(i).toString().getNumBytesAsUTF8();
+    };
+
+    size_t sendBytes = 0;
+    int numSends = 0;
+    for (int i = 0; i < sends.getNumProperties(); ++i)
+        if (const auto length = nameBytes(i); length > 0 && length <= 255) {
+            sendBytes += static_cast<size_t>(sendValueBytes + length);
+            ++numSends;
+        }
+
+    const size_t payloadBytes = static_cast<size_t>(numParameters) * 4 + sendBytes;
+    destData.setSize(static_cast<size_t>(headerBytes) + payloadBytes);
+
+    Writer out(static_cast<char*>(destData.getData()));
+    out.bytes(magic, sizeof(magic));
+    out.u16(formatVersion);
+    out.u16(static_cast<juce::uint16>(numParameters));
+    out.u16(static_cast<juce::uint16>(numSends));
+    out.u16(0);   // checksum, filled in once the payload is written
+    out.u32(static_cast<juce::uint32>(payloadBytes));
+
+    for (const auto* p : parameters)
+        out.f32(p->convertFrom0to1(p->getValue()));
+
+    for (int i = 0; i < sends.getNumProperties(); ++i) {
+        const auto length = nameBytes(i);
+        if (length == 0 || length > 255)
+            continue;
+
+        const auto name = sends.getPropertyName(i);
+        out.u8(static_cast<juce::uint8>(length));
+        out.bytes(name.getCharPointer().getAddress(), static_cast<size_t>(length));
+        out.f32(static_cast<float>(sends.getProperty(name)));
+    }
+
+    auto* block = static_cast<char*>(destData.getData());
+    Writer(block + checksumOffset).u16(fletcher16(block + headerBytes, payloadBytes));
+}
+
+bool StateCodec::read(const void* data, int sizeInBytes) {
+    if (! isBinaryState(data, sizeInBytes))
+        return false;
+
+    // Pass 1: validate everything before touching any state
+    Reader in(data, sizeInBytes);
+    Header h;
+    if (! readHeader(in, h) || h.version == 0 || h.version > formatVersion
+        || h.payloadBytes != static_cast<juce::uint32>(sizeInBytes - headerBytes))
+        return false;
+
+    if (h.version >= firstChecksummedVersion
+        && h.checksum != fletcher16(static_cast<const char*>(data) + headerBytes, h.payloadBytes))
+        return false;
+
+    const char* values = in.bytes(static_cast<size_t>(h.numParameters) * 4);
+    if (values == nullptr)
+        return false;
+
+    for (int i = 0; i < h.numSends; ++i) {
+        juce::uint8 length = 0;
+        float send = 0.0f;
+        if (! in.u8(length) || length == 0 || ! in.skip(length) || ! in.f32(send) || ! std::isfinite(send))
+            return false;
+    }
+    if (! in.atEnd())
+        return false;
+
+    // Pass 2: apply. Parameters go straight to the parameter objects (the
+    // APVTS mirrors them into its tree); unchanged ones are not touched, so
+    // the host sees no notification for them.
+    Reader valueIn(values, h.numParameters * 4);
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        auto* p = parameters[i];
+        float value = 0.0f;
+        const bool saved = i < static_cast<size_t>(h.numParameters) && valueIn.f32(value) && std::isfinite(value);
+        const float normalised = saved ? p->convertTo0to1(value) : p->getDefaultValue();
+
+        if (p->getValue() != normalised)
+            p->setValueNotifyingHost(normalised);
+    }
+
+    auto sends = apvts.state.getChildWithName(Solfeggio::State::channelSends);
+    if (h.numSends > 0 && ! sends.isValid())
+        sends = apvts.state.getOrCreateChildWithName(Solfeggio::State::channelSends, nullptr);
+    if (sends.isValid())
+        sends.removeAllProperties(nullptr);
+
+    Reader sendIn(values + h.numParameters * 4, static_cast<int>(h.payloadBytes) - h.numParameters * 4);
+    for (int i = 0; i < h.numSends; ++i) {
+        juce::uint8 length = 0;
+        float send = 0.0f;
+        sendIn.u8(length);
+        const char* name = sendIn.bytes(length);
+        sendIn.f32(send);
+        sends.setProperty(juce::Identifier(juce::String::fromUTF8(name, length)),
+                          juce::jlimit(0.0f, 1.0f, send), nullptr);
+    }
+    return true;
+}
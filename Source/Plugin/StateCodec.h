@@ -0,0 +1,54 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "Constants.h"
+
+// ============================================================================
+// StateCodec  (Plugin / Controller layer)
+// Responsibility: The plugin's saved state as a small versioned binary blob,
+// so a session with dozens of instances loads without an XML parse and a
+// ValueTree rebuild per instance.
+//
+// Layout, all little-endian:
+//   header   "SLFS", uint16 version, uint16 numParameters, uint16 numSends,
+//            uint16 Fletcher-16 of the payload (version 2 on; 0 before),
+//            uint32 payload bytes after the header
+//   values   float32 x numParameters — plain (denormalised) values in the
+//            stable order of parameterOrder() in StateCodec.cpp
+//   sends    numSends x { uint8 length, channel type abbreviation, float32 }
+//
+// The index in parameterOrder() is the on-disk key: append new parameters,
+// never reorder or remove. A blob with fewer values than we know leaves the
+// rest at their defaults; extra values from a newer build are skipped.
+// version moves only for a layout change older builds cannot read. The
+// checksum means a damaged blob is rejected whole instead of loading
+// flipped values.
+//
+// write() reads the parameters and the ChannelSends properties in place —
+// no ValueTree copy, XML or strings; the only allocation is sizing the
+// destination block. read() validates the whole blob first, then sets each
+// parameter that actually changes directly, and rewrites the sends child.
+// ============================================================================
+class StateCodec {
+public:
+    static constexpr juce::uint16 formatVersion = 2;
+    static constexpr int headerBytes = 16;
+    static constexpr int numParameters = 2 * Solfeggio::NUM_FREQUENCIES + 10;
+
+    explicit StateCodec(juce::AudioProcessorValueTreeState& apvts);
+
+    // True if the blob starts with our header (anything else is tried as XML)
+    static bool isBinaryState(const void* data, int sizeInBytes) noexcept;
+
+    void write(juce::MemoryBlock& destData) const;
+
+    // Applies the blob; returns false, changing nothing, if it is malformed
+    // or from a newer, incompatible format version
+    bool read(const void* data, int sizeInBytes);
+
+private:
+    juce::AudioProcessorValueTreeState& apvts;
+    std::array<juce::RangedAudioParameter*, numParameters> parameters {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StateCodec)
+};